@@ -6,15 +6,39 @@
 #include "mediapipe/framework/formats/landmark.pb.h"
 #include "mediapipe/util/render_data.pb.h"
 #include "mediapipe/framework/port/opencv_core_inc.h"
+#include "mediapipe/calculators/custom/eye_blink/eye_blink_calculator.pb.h"
+#include "mediapipe/calculators/custom/util/calculator_trace.h"
+#include "mediapipe/calculators/custom/util/config_input.h"
+#include "mediapipe/calculators/custom/util/gated_output.h"
+#include "mediapipe/calculators/custom/util/sparse_landmarks.h"
+#include "mediapipe/calculators/custom/util/stateless_calculator.h"
 
 namespace mediapipe
 {
 
+    namespace
+    {
+        constexpr char kSparseStreamTag[] = "SPARSE";
+
+        // Face mesh indices of the eyelids and the nose tip
+        constexpr int kRightEyeUpper = 386;
+        constexpr int kRightEyeLower = 374;
+        constexpr int kLeftEyeUpper  = 159;
+        constexpr int kLeftEyeLower  = 145;
+        constexpr int kNoseTip       = 1;
+        constexpr int kSparseIndices[] = { kRightEyeUpper, kRightEyeLower, kLeftEyeUpper, kLeftEyeLower, kNoseTip };
+    } // namespace
+
     /**
      * @brief Detect eye blinks from Standardized Landmarks
      * 
      * INPUTS:
      *      0 - Standardized Landmarks (NormalizedLandmarkList)
+     *      SPARSE - Alternative to 0, raw landmark subset standardized here
+     *               (SparseLandmarks), see SparseLandmarkViewCalculator
+     *      GATE - (Optional) Recompute when true, else re-emit the previous output (bool)
+     *      CONFIG - (Optional) Replaces the threshold model from then on
+     *               (EyeBlinkCalculatorOptions), see ConfigInput
      * OUTPUTS:
      *      0 - Eye Blink data (std::map<std::string, double>)
      *      {
@@ -29,11 +53,20 @@ namespace mediapipe
      *   calculator: "EyeBlinkCalculator"
      *   input_stream: "face_std_landmarks"
      *   output_stream: "face_blinks"
+     *   node_options: {
+     *     [type.googleapis.com/mediapipe.EyeBlinkCalculatorOptions] {
+     *       bias: 0.15
+     *     }
+     *   }
      * }
      * 
      */
     class EyeBlinkCalculator: public CalculatorBase
     {
+    private:
+        GatedOutput m_gate;
+        ConfigInput<EyeBlinkCalculatorOptions> m_config;
+
     public:
         EyeBlinkCalculator() = default;
         ~EyeBlinkCalculator() override = default;
@@ -48,38 +81,77 @@ namespace mediapipe
 
     // Register the calculator to be used in the graph
     REGISTER_CALCULATOR(EyeBlinkCalculator);
+    REGISTER_STATELESS_CALCULATOR(EyeBlinkCalculator);
+    REGISTER_SPARSE_LANDMARK_INDICES(EyeBlinkCalculator, kSparseIndices);
 
     absl::Status EyeBlinkCalculator::GetContract(CalculatorContract* cc)
     {
-        cc->Inputs().Index(0).Set<NormalizedLandmarkList>();
+        if (cc->Inputs().HasTag(kSparseStreamTag))
+        {
+            cc->Inputs().Tag(kSparseStreamTag).Set<SparseLandmarks>();
+        }else
+        {
+            cc->Inputs().Index(0).Set<NormalizedLandmarkList>();
+        }
         cc->Outputs().Index(0).Set<std::map<std::string, double>>();
+        MP_RETURN_IF_ERROR(GatedOutput::SetContract(cc));
+        ConfigInput<EyeBlinkCalculatorOptions>::SetContract(cc);
         return absl::OkStatus();
     }
 
     absl::Status EyeBlinkCalculator::Open(CalculatorContext* cc)
-    { return absl::OkStatus(); }
+    {
+        m_config.Open(cc->Options<EyeBlinkCalculatorOptions>());
+        cc->SetOffset(TimestampDiff(0));
+        return absl::OkStatus();
+    }
 
     absl::Status EyeBlinkCalculator::Process(CalculatorContext* cc)
     {
-        auto landmarks = cc->Inputs().Index(0).Get<NormalizedLandmarkList>();
+        CALCULATOR_TRACE_SCOPE("EyeBlinkCalculator", cc);
+        MP_RETURN_IF_ERROR(m_gate.Update(cc));
+        const bool reconfigured = m_config.Update(cc);
+        const bool from_sparse = cc->Inputs().HasTag(kSparseStreamTag);
+        const auto& input = from_sparse ? cc->Inputs().Tag(kSparseStreamTag): cc->Inputs().Index(0);
+        if (input.IsEmpty()) { return absl::OkStatus(); }
+        if (!reconfigured && m_gate.Reemit(cc, cc->Outputs().Index(0))) { return absl::OkStatus(); }
+
+        // Standardized x, y of a landmark from either input
+        const SparseLandmarks* sparse = from_sparse ? &input.Get<SparseLandmarks>(): nullptr;
+        const NormalizedLandmarkList* landmarks = from_sparse ? nullptr: &input.Get<NormalizedLandmarkList>();
+        if (sparse && !sparse->HasAll(kSparseIndices))
+        {
+            return absl::InvalidArgumentError("SparseLandmarks lacks the EyeBlinkCalculator landmarks");
+        }
+        auto point = [&](int index) -> cv::Vec3d {
+            if (sparse)
+            {
+                const auto standardized = sparse->Standardized(index);
+                return { standardized[0], standardized[1] };
+            }
+            return { landmarks->landmark(index).x(), landmarks->landmark(index).y() };
+        };
         std::map<std::string, double> blink_map;
         
         // Right Eye
-        cv::Vec3d ur_el { landmarks.landmark(386).x(), landmarks.landmark(386).y() };
-        cv::Vec3d lr_el { landmarks.landmark(374).x(), landmarks.landmark(374).y() };
+        cv::Vec3d ur_el = point(kRightEyeUpper);
+        cv::Vec3d lr_el = point(kRightEyeLower);
 
         // Left Eye
-        cv::Vec3d ul_el { landmarks.landmark(159).x(), landmarks.landmark(159).y() };
-        cv::Vec3d ll_el { landmarks.landmark(145).x(), landmarks.landmark(145).y() };
+        cv::Vec3d ul_el = point(kLeftEyeUpper);
+        cv::Vec3d ll_el = point(kLeftEyeLower);
 
         auto r_dist = cv::norm(ur_el - lr_el, cv::NORM_L2);
         auto l_dist = cv::norm(ul_el - ll_el, cv::NORM_L2);
 
         blink_map["left"] = l_dist;
         blink_map["right"] = r_dist;
-        blink_map["threshold"] = landmarks.landmark(1).x() * 0.0308 + landmarks.landmark(1).y() * 0.0803 + 0.1476;
+        const auto& model = m_config.Get();
+        const cv::Vec3d nose = point(kNoseTip);
+        blink_map["threshold"] = nose[0] * model.x_coefficient() + nose[1] * model.y_coefficient() + model.bias();
 
         Packet packet = MakePacket<decltype(blink_map)>(blink_map).At(cc->InputTimestamp());
+        m_gate.Remember(cc, packet);
         cc->Outputs().Index(0).AddPacket(packet);
 
         return absl::OkStatus();
@@ -7,6 +7,10 @@
 #include "mediapipe/framework/formats/landmark.pb.h"
 #include "mediapipe/util/color.pb.h"
 #include "mediapipe/util/render_data.pb.h"
+#include "mediapipe/calculators/custom/util/arena_packet.h"
+#include "mediapipe/calculators/custom/util/calculator_trace.h"
+#include "mediapipe/calculators/custom/util/gated_output.h"
+#include "mediapipe/calculators/custom/util/stateless_calculator.h"
 
 namespace mediapipe
 {
@@ -22,6 +26,7 @@ namespace mediapipe
      * 
      * INPUTS:
      *      BLINK - Blinks (std::vector<std::map<std::string, double> >)
+     *      GATE - (Optional) Recompute when true, else re-emit the previous output (bool)
      * OUTPUTS:
      *      RENDER - Render Data to be render by OverlayRenderer (RenderData)
      * 
@@ -37,6 +42,9 @@ namespace mediapipe
     class EyeBlinkToRenderDataCalculator: public CalculatorBase
     {
     private:
+        GatedOutput m_gate;
+        ArenaPool m_arena_pool { kRenderDataArenaBlockSize };
+
         void AnnotateBlink(RenderData& render_data, std::string blink, double left_pos);
 
     public:
@@ -52,16 +60,21 @@ namespace mediapipe
     };
     // Register the calculator to be used in the graph
     REGISTER_CALCULATOR(EyeBlinkToRenderDataCalculator);
+    REGISTER_STATELESS_CALCULATOR(EyeBlinkToRenderDataCalculator);
 
     absl::Status EyeBlinkToRenderDataCalculator::GetContract(CalculatorContract* cc)
     {
         cc->Inputs().Tag(kBlinkStreamTag).Set<std::vector<std::map<std::string, double> > >();
         cc->Outputs().Tag(kRenderDataStreamTag).Set<RenderData>();
+        MP_RETURN_IF_ERROR(GatedOutput::SetContract(cc));
         return absl::OkStatus();
     }
 
     absl::Status EyeBlinkToRenderDataCalculator::Open(CalculatorContext* cc)
-    { return absl::OkStatus(); }
+    {
+        cc->SetOffset(TimestampDiff(0));
+        return absl::OkStatus();
+    }
 
 
     void EyeBlinkToRenderDataCalculator::AnnotateBlink(RenderData& render_data, std::string blink, double left_pos)
@@ -90,7 +103,12 @@ namespace mediapipe
 
     absl::Status EyeBlinkToRenderDataCalculator::Process(CalculatorContext* cc)
     {
-        RenderData render_data;
+        CALCULATOR_TRACE_SCOPE("EyeBlinkToRenderDataCalculator", cc);
+        MP_RETURN_IF_ERROR(m_gate.Update(cc));
+        if (m_gate.Reemit(cc, cc->Outputs().Tag(kRenderDataStreamTag))) { return absl::OkStatus(); }
+
+        auto arena = m_arena_pool.Acquire();
+        auto render_data = google::protobuf::Arena::CreateMessage<RenderData>(arena.get());
         if (!cc->Inputs().Tag(kBlinkStreamTag).IsEmpty())
         {
             auto multi_face_blinks = cc->Inputs().Tag(kBlinkStreamTag).Get<std::vector<std::map<std::string, double> > >();
@@ -101,12 +119,13 @@ namespace mediapipe
                 std::string left_blink     = blink.at("left") < threshold ? "Blink": "";
                 std::string right_blink    = blink.at("right") < threshold ? "Blink": "";
             
-                this->AnnotateBlink(render_data, left_blink, 0.08);
-                this->AnnotateBlink(render_data, right_blink, 0.64);
+                this->AnnotateBlink(*render_data, left_blink, 0.08);
+                this->AnnotateBlink(*render_data, right_blink, 0.64);
             }
         }
         
-        Packet packet = MakePacket<decltype(render_data)>(render_data).At(cc->InputTimestamp());
+        Packet packet = MakeArenaPacket(render_data, std::move(arena)).At(cc->InputTimestamp());
+        m_gate.Remember(cc, packet);
         cc->Outputs().Tag(kRenderDataStreamTag).AddPacket(packet);
 
         return absl::OkStatus();
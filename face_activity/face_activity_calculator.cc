@@ -1,22 +1,89 @@
 #include <vector>
-#include <map>
+#include <array>
+#include <cmath>
+#include <cstdint>
 #include <optional>
 
 #include "absl/memory/memory.h"
 #include "mediapipe/framework/calculator_framework.h"
 #include "mediapipe/framework/port/status.h"
-#include "mediapipe/framework/port/opencv_core_inc.h"
 #include "mediapipe/framework/formats/landmark.pb.h"
+#include "mediapipe/calculators/custom/face_activity/face_region_activity.h"
+#include "mediapipe/calculators/custom/face_activity/face_activity_calculator.pb.h"
+#include "mediapipe/calculators/custom/util/landmark_tensor.h"
+#include "mediapipe/calculators/custom/util/face_id.h"
+#include "mediapipe/calculators/custom/util/face_state_map.h"
+#include "mediapipe/calculators/custom/util/frame_interval.h"
+#include "mediapipe/calculators/custom/util/calculator_trace.h"
 
 namespace mediapipe
 {
+
+    namespace
+    {
+        constexpr char kRegionsStreamTag[] = "REGIONS";
+
+        // Face mesh landmark indices of each region (image side for left/right)
+        constexpr int kMouthIndices[] = {
+            61, 146, 91, 181, 84, 17, 314, 405, 321, 375, 291, 185, 40, 39, 37, 0,
+            267, 269, 270, 409, 78, 95, 88, 178, 87, 14, 317, 402, 318, 324, 308, 191,
+            80, 81, 82, 13, 312, 311, 310, 415
+        };
+        constexpr int kLeftEyeIndices[] = {
+            33, 7, 163, 144, 145, 153, 154, 155, 133, 246, 161, 160, 159, 158, 157, 173
+        };
+        constexpr int kRightEyeIndices[] = {
+            263, 249, 390, 373, 374, 380, 381, 382, 362, 466, 388, 387, 386, 385, 384, 398
+        };
+        constexpr int kBrowIndices[] = {
+            46, 53, 52, 65, 55, 70, 63, 105, 66, 107,
+            276, 283, 282, 295, 285, 300, 293, 334, 296, 336
+        };
+        constexpr int kJawIndices[] = {
+            361, 288, 397, 365, 379, 378, 400, 377, 152, 148, 176, 149, 150, 136, 172, 58, 132
+        };
+
+        constexpr int kRegionTableSize = 478;
+
+        // Bit mask of the regions each landmark belongs to
+        std::array<uint8_t, kRegionTableSize> BuildRegionTable()
+        {
+            std::array<uint8_t, kRegionTableSize> table {};
+            auto mark = [&table](const auto& indices, FaceRegion region) {
+                for (int index: indices) { table[index] |= 1 << region; }
+            };
+            mark(kMouthIndices, FACE_REGION_MOUTH);
+            mark(kLeftEyeIndices, FACE_REGION_LEFT_EYE);
+            mark(kRightEyeIndices, FACE_REGION_RIGHT_EYE);
+            mark(kBrowIndices, FACE_REGION_BROWS);
+            mark(kJawIndices, FACE_REGION_JAW);
+            return table;
+        }
+
+        struct PreviousFrame
+        {
+            // Landmarks as packed xyz triplets, reused across frames
+            std::vector<float> landmarks;
+            int64_t timestamp_us = 0;
+        };
+    } // namespace
+
     /**
      * @brief Detect facial activity changes
      * 
      * INPUTS:
      *      0 - Standardized Landmarks (NormalizedLandmarkList)
+     *      TENSORS - Alternative to 0, face mesh model output read in place
+     *                (std::vector<Tensor>); deltas are then in normalized image
+     *                coordinates, see LandmarkTensorReader
+     *      FACE_ID - (Optional) Face Id from FaceTrackerCalculator (int),
+     *                previous landmarks are kept per face
+     *                until unseen for face_timeout_ms
+     *      TIMESTAMP - (Optional) Frame timestamp cloned into a loop (Timestamp),
+     *                  see FrameInterval
      * OUTPUTS:
-     *      0 - Facial Activity Delta (double)
+     *      0 - Facial Activity Delta (double), per second with normalize_by_time
+     *      REGIONS - (Optional) Per-region Activity Deltas (FaceRegionActivity)
      * 
      * Example:
      * 
@@ -24,13 +91,23 @@ namespace mediapipe
      *   calculator: "FaceActivityCalculator"
      *   input_stream: "face_std_landmarks"
      *   output_stream: "face_activities"
+     *   output_stream: "REGIONS:face_region_activities"
+     *   node_options: {
+     *     [type.googleapis.com/mediapipe.FaceActivityCalculatorOptions] {
+     *       normalize_by_time: true
+     *     }
+     *   }
      * }
      * 
      */
     class FaceActivityCalculator: public CalculatorBase
     {
     private:
-        cv::Mat m_prev_landmark_mat;
+        std::array<uint8_t, kRegionTableSize> m_region_table = BuildRegionTable();
+        FaceStateMap<PreviousFrame> m_prev_frames;
+        LandmarkTensorReader m_tensor_reader;
+        FrameInterval m_interval;
+        int64_t m_face_timeout_us = 0;
 
     public:
         FaceActivityCalculator() = default;
@@ -48,36 +125,99 @@ namespace mediapipe
 
     absl::Status FaceActivityCalculator::GetContract(CalculatorContract* cc)
     {
-        cc->Inputs().Index(0).Set<NormalizedLandmarkList>();
+        if (LandmarkTensorReader::HasInput(cc))
+        {
+            LandmarkTensorReader::SetContract(cc);
+        }else
+        {
+            cc->Inputs().Index(0).Set<NormalizedLandmarkList>();
+        }
+        MP_RETURN_IF_ERROR(FaceId::SetContract(cc));
+        FrameInterval::SetContract(cc);
         cc->Outputs().Index(0).Set<double>();
+        if (cc->Outputs().HasTag(kRegionsStreamTag))
+        {
+            cc->Outputs().Tag(kRegionsStreamTag).Set<FaceRegionActivity>();
+        }
         return absl::OkStatus();
     }
 
     absl::Status FaceActivityCalculator::Open(CalculatorContext* cc)
-    { return absl::OkStatus(); }
+    {
+        const auto& options = cc->Options<FaceActivityCalculatorOptions>();
+        m_interval.Open(options.normalize_by_time(), options.max_gap_ms());
+        m_face_timeout_us = options.face_timeout_ms() * 1000;
+        m_tensor_reader.Open(cc);
+        return absl::OkStatus();
+    }
 
     absl::Status FaceActivityCalculator::Process(CalculatorContext* cc)
     {
-        auto landmarks = cc->Inputs().Index(0).Get<NormalizedLandmarkList>();
-        cv::Mat cur_landmark_mat(landmarks.landmark_size(), 3, CV_64FC1);
+        CALCULATOR_TRACE_SCOPE("FaceActivityCalculator", cc);
+        const bool from_tensor = cc->Inputs().HasTag(LandmarkTensorReader::kTensorsTag);
+        const int num_landmarks = from_tensor ?
+            m_tensor_reader.NumLandmarks(cc):
+            cc->Inputs().Index(0).Get<NormalizedLandmarkList>().landmark_size();
 
-        for (int i = 0; i < landmarks.landmark_size(); ++i) {
-            cur_landmark_mat.at<double>(i, 0) = landmarks.landmark(i).x();
-            cur_landmark_mat.at<double>(i, 1) = landmarks.landmark(i).y();
-            cur_landmark_mat.at<double>(i, 2) = landmarks.landmark(i).z();
+        // Initialize previous landmarks, the first delta of a face is zero
+        const auto face_id = FaceId::Of(cc);
+        if (!face_id.ok()) { return face_id.status(); }
+        const auto now = FrameInterval::Now(cc);
+        if (!now.ok()) { return now.status(); }
+        const int64_t now_us = *now;
+        m_prev_frames.Expire(now_us, m_face_timeout_us);
+        auto& prev_frame = m_prev_frames.Get(*face_id, now_us);
+        auto& face_prev_landmarks = prev_frame.landmarks;
+        const bool is_first = static_cast<int>(face_prev_landmarks.size()) != num_landmarks * 3;
+        if (is_first) { face_prev_landmarks.resize(num_landmarks * 3); }
+        const double scale = m_interval.Scale(is_first, prev_frame.timestamp_us, now_us);
+        prev_frame.timestamp_us = now_us;
+
+        // Single pass accumulating squared deltas for the whole mesh and every region
+        double total_sq = 0.0;
+        std::array<double, FACE_REGION_COUNT> region_sq {};
+        float* prev_landmarks = face_prev_landmarks.data();
+        auto accumulate = [&](int i, float x, float y, float z) {
+            float* prev = prev_landmarks + 3 * i;
+            const double dx = is_first ? 0.0: x - prev[0];
+            const double dy = is_first ? 0.0: y - prev[1];
+            const double dz = is_first ? 0.0: z - prev[2];
+            prev[0] = x; prev[1] = y; prev[2] = z;
+
+            const double sq = dx * dx + dy * dy + dz * dz;
+            total_sq += sq;
+            const uint8_t mask = i < kRegionTableSize ? m_region_table[i]: 0;
+            for (int r = 0; r < FACE_REGION_COUNT; ++r)
+            {
+                region_sq[r] += ((mask >> r) & 1) * sq;
+            }
+        };
+        if (from_tensor)
+        {
+            MP_RETURN_IF_ERROR(m_tensor_reader.ForEach(cc, accumulate));
+        }else
+        {
+            const auto& landmarks = cc->Inputs().Index(0).Get<NormalizedLandmarkList>();
+            for (int i = 0; i < num_landmarks; ++i)
+            {
+                const auto& landmark = landmarks.landmark(i);
+                accumulate(i, landmark.x(), landmark.y(), landmark.z());
+            }
         }
-        
-        // Initialize prev_landmark_mat
-        if (m_prev_landmark_mat.size().area() == 0)
+
+        const double delta = scale * std::sqrt(total_sq);
+        cc->Outputs().Index(0).AddPacket(MakePacket<double>(delta).At(cc->InputTimestamp()));
+
+        if (cc->Outputs().HasTag(kRegionsStreamTag))
         {
-            m_prev_landmark_mat = cur_landmark_mat;
+            auto activity = absl::make_unique<FaceRegionActivity>();
+            activity->total = delta;
+            for (int r = 0; r < FACE_REGION_COUNT; ++r)
+            {
+                activity->regions[r] = scale * std::sqrt(region_sq[r]);
+            }
+            cc->Outputs().Tag(kRegionsStreamTag).Add(activity.release(), cc->InputTimestamp());
         }
-        
-        auto delta = cv::norm(cur_landmark_mat - m_prev_landmark_mat, cv::NORM_L2);
-        m_prev_landmark_mat = cur_landmark_mat;
-            
-        Packet packet = MakePacket<double>(delta).At(cc->InputTimestamp());
-        cc->Outputs().Index(0).AddPacket(packet);
 
         return absl::OkStatus();
     } // Process()
@@ -1,3 +1,4 @@
+#include <cstdint>
 #include <vector>
 #include <map>
 #include <optional>
@@ -7,16 +8,45 @@
 #include "mediapipe/framework/port/status.h"
 #include "mediapipe/framework/port/opencv_core_inc.h"
 #include "mediapipe/framework/formats/landmark.pb.h"
+#include "mediapipe/calculators/custom/util/calculator_trace.h"
+#include "mediapipe/calculators/custom/util/face_id.h"
+#include "mediapipe/calculators/custom/util/face_state_map.h"
+#include "mediapipe/calculators/custom/util/frame_interval.h"
+#include "mediapipe/calculators/custom/face_activity/face_movement_calculator.pb.h"
+#include "mediapipe/calculators/custom/util/sparse_landmarks.h"
 
 namespace mediapipe
 {
+
+    namespace
+    {
+        constexpr char kSparseStreamTag[] = "SPARSE";
+
+        // Face mesh index tracked for the face position
+        constexpr int kAnchor = 0;
+        constexpr int kSparseIndices[] = { kAnchor };
+
+        struct PreviousPosition
+        {
+            cv::Vec3f position;
+            int64_t timestamp_us = 0;
+        };
+    } // namespace
+
     /**
      * @brief Detect face position changes on screen
      * 
      * INPUTS:
      *      0 - Landmarks (NormalizedLandmarkList)
+     *      SPARSE - Alternative to 0, landmark subset (SparseLandmarks),
+     *               see SparseLandmarkViewCalculator
+     *      FACE_ID - (Optional) Face Id from FaceTrackerCalculator (int),
+     *                previous position is kept per face
+     *                until unseen for face_timeout_ms
+     *      TIMESTAMP - (Optional) Frame timestamp cloned into a loop (Timestamp),
+     *                  see FrameInterval
      * OUTPUTS:
-     *      0 - Face Position Delta (double)
+     *      0 - Face Position Delta (double), per second with normalize_by_time
      * 
      * Example:
      * 
@@ -24,13 +54,22 @@ namespace mediapipe
      *   calculator: "FaceMovementCalculator"
      *   input_stream: "face_landmarks"
      *   output_stream: "face_movement"
+     *   node_options: {
+     *     [type.googleapis.com/mediapipe.FaceMovementCalculatorOptions] {
+     *       normalize_by_time: true
+     *       max_gap_ms: 300
+     *     }
+     *   }
      * }
      * 
      */
     class FaceMovementCalculator: public CalculatorBase
     {
     private:
-        cv::Vec3f m_prev_vec;
+        // Previous position of each face, the first delta of a face is zero
+        FaceStateMap<PreviousPosition> m_prev_positions;
+        FrameInterval m_interval;
+        int64_t m_face_timeout_us = 0;
 
     public:
         FaceMovementCalculator() = default;
@@ -45,24 +84,61 @@ namespace mediapipe
 
     // Register the calculator to be used in the graph
     REGISTER_CALCULATOR(FaceMovementCalculator);
+    REGISTER_SPARSE_LANDMARK_INDICES(FaceMovementCalculator, kSparseIndices);
 
     absl::Status FaceMovementCalculator::GetContract(CalculatorContract* cc)
     {
-        cc->Inputs().Index(0).Set<NormalizedLandmarkList>();
+        if (cc->Inputs().HasTag(kSparseStreamTag))
+        {
+            cc->Inputs().Tag(kSparseStreamTag).Set<SparseLandmarks>();
+        }else
+        {
+            cc->Inputs().Index(0).Set<NormalizedLandmarkList>();
+        }
+        MP_RETURN_IF_ERROR(FaceId::SetContract(cc));
+        FrameInterval::SetContract(cc);
         cc->Outputs().Index(0).Set<double>();
         return absl::OkStatus();
     }
 
     absl::Status FaceMovementCalculator::Open(CalculatorContext* cc)
-    { return absl::OkStatus(); }
+    {
+        const auto& options = cc->Options<FaceMovementCalculatorOptions>();
+        m_interval.Open(options.normalize_by_time(), options.max_gap_ms());
+        m_face_timeout_us = options.face_timeout_ms() * 1000;
+        return absl::OkStatus();
+    }
 
     absl::Status FaceMovementCalculator::Process(CalculatorContext* cc)
     {
-        auto landmarks = cc->Inputs().Index(0).Get<NormalizedLandmarkList>();
-        auto cur_landmark = landmarks.landmark(0);
-        cv::Vec3f cur_vec (cur_landmark.x(), cur_landmark.y(), cur_landmark.z());
-        auto delta = cv::norm(cur_vec - m_prev_vec, cv::NORM_L2);
-        m_prev_vec = cur_vec;
+        CALCULATOR_TRACE_SCOPE("FaceMovementCalculator", cc);
+        cv::Vec3f cur_vec;
+        if (cc->Inputs().HasTag(kSparseStreamTag))
+        {
+            const auto& sparse = cc->Inputs().Tag(kSparseStreamTag).Get<SparseLandmarks>();
+            if (!sparse.HasAll(kSparseIndices))
+            {
+                return absl::InvalidArgumentError("SparseLandmarks lacks the FaceMovementCalculator landmarks");
+            }
+            const auto anchor = sparse.Raw(kAnchor);
+            cur_vec = cv::Vec3f(anchor[0], anchor[1], anchor[2]);
+        }else
+        {
+            const auto& cur_landmark = cc->Inputs().Index(0).Get<NormalizedLandmarkList>().landmark(kAnchor);
+            cur_vec = cv::Vec3f(cur_landmark.x(), cur_landmark.y(), cur_landmark.z());
+        }
+        const auto face_id = FaceId::Of(cc);
+        if (!face_id.ok()) { return face_id.status(); }
+        bool is_first;
+        const auto now = FrameInterval::Now(cc);
+        if (!now.ok()) { return now.status(); }
+        const int64_t now_us = *now;
+        m_prev_positions.Expire(now_us, m_face_timeout_us);
+        PreviousPosition& prev = m_prev_positions.Get(*face_id, now_us, &is_first);
+        const double scale = m_interval.Scale(is_first, prev.timestamp_us, now_us);
+        auto delta = scale == 0.0 ? 0.0: scale * cv::norm(cur_vec - prev.position, cv::NORM_L2);
+        prev.position = cur_vec;
+        prev.timestamp_us = now_us;
             
         Packet packet = MakePacket<decltype(delta)>(delta).At(cc->InputTimestamp());
         cc->Outputs().Index(0).AddPacket(packet);
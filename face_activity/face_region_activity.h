@@ -0,0 +1,23 @@
+#pragma once
+
+#include <array>
+
+// Facial regions tracked by FaceActivityCalculator.
+// Left/Right follow the image side, as in EyeBlinkCalculator.
+enum FaceRegion
+{
+    FACE_REGION_MOUTH = 0,
+    FACE_REGION_LEFT_EYE,
+    FACE_REGION_RIGHT_EYE,
+    FACE_REGION_BROWS,
+    FACE_REGION_JAW,
+    FACE_REGION_COUNT
+};
+
+struct FaceRegionActivity
+{
+    // L2 delta over the whole mesh, same as FaceActivityCalculator's main output
+    double total;
+    // L2 delta over each region's landmarks, indexed by FaceRegion
+    std::array<double, FACE_REGION_COUNT> regions;
+};
@@ -0,0 +1,203 @@
+#include <algorithm>
+#include <cstdint>
+
+#include "absl/memory/memory.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/port/status.h"
+#include "mediapipe/framework/port/logging.h"
+#include "mediapipe/calculators/custom/face_activity/face_region_activity.h"
+#include "mediapipe/calculators/custom/face_activity/motion_gate_calculator.pb.h"
+#include "mediapipe/calculators/custom/util/calculator_trace.h"
+#include "mediapipe/calculators/custom/util/face_id.h"
+#include "mediapipe/calculators/custom/util/face_state_map.h"
+#include "mediapipe/calculators/custom/util/frame_interval.h"
+
+namespace mediapipe
+{
+
+    namespace
+    {
+        constexpr char kActivityStreamTag[] = "ACTIVE";
+        constexpr char kMovementStreamTag[] = "MOVE";
+        constexpr char kRegionsStreamTag[]  = "REGIONS";
+        constexpr char kGateStreamTag[]     = "GATE";
+        constexpr char kHitRateStreamTag[]  = "HIT_RATE";
+
+        // Deltas accumulated since the last refresh of one face
+        struct GateState
+        {
+            double activity_sum = 0.0;
+            double movement_sum = 0.0;
+            double left_eye_sum = 0.0;
+            double right_eye_sum = 0.0;
+            int skipped_frames = 0;
+            bool has_refreshed = false;
+        };
+    } // namespace
+
+    /**
+     * @brief Decide whether downstream signals need recomputing
+     *
+     * Accumulates the cheap per-frame deltas of FaceActivityCalculator and
+     * FaceMovementCalculator since the last refresh. While every sum stays under
+     * its epsilon the gate is closed (false) and gated calculators re-emit their
+     * previous result instead of recomputing. A missing delta opens the gate.
+     *
+     * INPUTS:
+     *      ACTIVE - Facial Activity Delta (double)
+     *      MOVE - Face Position Delta (double)
+     *      REGIONS - (Optional) Per-region Activity Deltas (FaceRegionActivity),
+     *                keeps blinks from being gated away
+     *      FACE_ID - (Optional) Face Id from FaceTrackerCalculator (int),
+     *                sums are kept per face until unseen for face_timeout_ms
+     *      TIMESTAMP - (Optional) Frame timestamp cloned into a loop (Timestamp),
+     *                  see FrameInterval
+     * OUTPUTS:
+     *      GATE - true when downstream calculators should recompute (bool)
+     *      HIT_RATE - (Optional) Fraction of frames skipped so far (double)
+     *
+     * Example:
+     *
+     * node {
+     *   calculator: "MotionGateCalculator"
+     *   input_stream: "ACTIVE:face_activities"
+     *   input_stream: "MOVE:face_movement"
+     *   input_stream: "REGIONS:face_region_activities"
+     *   output_stream: "GATE:motion_gate"
+     *   node_options: {
+     *     [type.googleapis.com/mediapipe.MotionGateCalculatorOptions] {
+     *       activity_epsilon: 0.05
+     *       max_skipped_frames: 15
+     *     }
+     *   }
+     * }
+     *
+     * node {
+     *   calculator: "EyeBlinkCalculator"
+     *   input_stream: "face_std_landmarks"
+     *   input_stream: "GATE:motion_gate"
+     *   output_stream: "face_blinks"
+     * }
+     *
+     */
+    class MotionGateCalculator: public CalculatorBase
+    {
+    private:
+        MotionGateCalculatorOptions m_options;
+
+        FaceStateMap<GateState> m_states;
+
+        int64_t m_total_frames = 0;
+        int64_t m_gated_frames = 0;
+
+    public:
+        MotionGateCalculator() = default;
+        ~MotionGateCalculator() override = default;
+
+        static absl::Status GetContract(CalculatorContract* cc);
+
+        absl::Status Open(CalculatorContext* cc) override;
+        absl::Status Process(CalculatorContext* cc) override;
+        absl::Status Close(CalculatorContext* cc) override;
+    };
+
+    // Register the calculator to be used in the graph
+    REGISTER_CALCULATOR(MotionGateCalculator);
+
+    absl::Status MotionGateCalculator::GetContract(CalculatorContract* cc)
+    {
+        cc->Inputs().Tag(kActivityStreamTag).Set<double>();
+        cc->Inputs().Tag(kMovementStreamTag).Set<double>();
+        if (cc->Inputs().HasTag(kRegionsStreamTag))
+        {
+            cc->Inputs().Tag(kRegionsStreamTag).Set<FaceRegionActivity>();
+        }
+        MP_RETURN_IF_ERROR(FaceId::SetContract(cc));
+        FrameInterval::SetContract(cc);
+        cc->Outputs().Tag(kGateStreamTag).Set<bool>();
+        if (cc->Outputs().HasTag(kHitRateStreamTag))
+        {
+            cc->Outputs().Tag(kHitRateStreamTag).Set<double>();
+        }
+        return absl::OkStatus();
+    }
+
+    absl::Status MotionGateCalculator::Open(CalculatorContext* cc)
+    {
+        m_options = cc->Options<MotionGateCalculatorOptions>();
+        cc->SetOffset(TimestampDiff(0));
+        return absl::OkStatus();
+    }
+
+    absl::Status MotionGateCalculator::Process(CalculatorContext* cc)
+    {
+        CALCULATOR_TRACE_SCOPE("MotionGateCalculator", cc);
+        const auto face_id = FaceId::Of(cc);
+        if (!face_id.ok()) { return face_id.status(); }
+        const auto now = FrameInterval::Now(cc);
+        if (!now.ok()) { return now.status(); }
+        const int64_t now_us = *now;
+        m_states.Expire(now_us, m_options.face_timeout_ms() * 1000);
+        GateState& state = m_states.Get(*face_id, now_us);
+
+        bool is_open = !state.has_refreshed ||
+                       cc->Inputs().Tag(kActivityStreamTag).IsEmpty() ||
+                       cc->Inputs().Tag(kMovementStreamTag).IsEmpty();
+        if (!is_open)
+        {
+            // Sums of per-frame deltas bound the change since the last refresh
+            state.activity_sum += cc->Inputs().Tag(kActivityStreamTag).Get<double>();
+            state.movement_sum += cc->Inputs().Tag(kMovementStreamTag).Get<double>();
+            is_open = state.activity_sum >= m_options.activity_epsilon() ||
+                      state.movement_sum >= m_options.movement_epsilon();
+
+            if (cc->Inputs().HasTag(kRegionsStreamTag))
+            {
+                if (cc->Inputs().Tag(kRegionsStreamTag).IsEmpty())
+                {
+                    is_open = true;
+                }else
+                {
+                    const auto& regions = cc->Inputs().Tag(kRegionsStreamTag).Get<FaceRegionActivity>().regions;
+                    state.left_eye_sum += regions[FACE_REGION_LEFT_EYE];
+                    state.right_eye_sum += regions[FACE_REGION_RIGHT_EYE];
+                    is_open = is_open ||
+                              std::max(state.left_eye_sum, state.right_eye_sum) >= m_options.eye_epsilon();
+                }
+            }
+            is_open = is_open || state.skipped_frames >= m_options.max_skipped_frames();
+        }
+
+        if (is_open)
+        {
+            state = GateState();
+            state.has_refreshed = true;
+        }else
+        {
+            ++state.skipped_frames;
+            ++m_gated_frames;
+        }
+        ++m_total_frames;
+
+        cc->Outputs().Tag(kGateStreamTag).AddPacket(MakePacket<bool>(is_open).At(cc->InputTimestamp()));
+        if (cc->Outputs().HasTag(kHitRateStreamTag))
+        {
+            const double hit_rate = static_cast<double>(m_gated_frames) / m_total_frames;
+            cc->Outputs().Tag(kHitRateStreamTag).AddPacket(MakePacket<double>(hit_rate).At(cc->InputTimestamp()));
+        }
+
+        return absl::OkStatus();
+    } // Process()
+
+    absl::Status MotionGateCalculator::Close(CalculatorContext* cc)
+    {
+        if (m_total_frames > 0)
+        {
+            LOG(INFO) << "MotionGateCalculator skipped " << m_gated_frames << " of "
+                      << m_total_frames << " frames ("
+                      << 100.0 * m_gated_frames / m_total_frames << "%)";
+        }
+        return absl::OkStatus();
+    }
+
+} // namespace mediapipe
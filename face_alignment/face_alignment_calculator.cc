@@ -5,14 +5,31 @@
 #include "mediapipe/framework/calculator_framework.h"
 #include "mediapipe/framework/port/status.h"
 #include "mediapipe/framework/formats/landmark.pb.h"
+#include "mediapipe/calculators/custom/util/calculator_trace.h"
+#include "mediapipe/calculators/custom/util/gated_output.h"
+#include "mediapipe/calculators/custom/util/sparse_landmarks.h"
+#include "mediapipe/calculators/custom/util/stateless_calculator.h"
 
 namespace mediapipe
 {
+
+    namespace
+    {
+        constexpr char kSparseStreamTag[] = "SPARSE";
+
+        // Face mesh index of the nose tip
+        constexpr int kNoseTip = 1;
+        constexpr int kSparseIndices[] = { kNoseTip };
+    } // namespace
+
     /**
      * @brief Detect face orientations from Standardized Landmarks
      * 
      * INPUTS:
      *      0 - Standardized Landmarks (NormalizedLandmarkList)
+     *      SPARSE - Alternative to 0, raw landmark subset standardized here
+     *               (SparseLandmarks), see SparseLandmarkViewCalculator
+     *      GATE - (Optional) Recompute when true, else re-emit the previous output (bool)
      * OUTPUTS:
      *      0 - Face orientation data (std::map<std::string, double>)
      *      {
@@ -31,6 +48,9 @@ namespace mediapipe
      */
     class FaceOrientationCalculator: public CalculatorBase
     {
+    private:
+        GatedOutput m_gate;
+
     public:
         FaceOrientationCalculator() = default;
         ~FaceOrientationCalculator() override = default;
@@ -45,25 +65,55 @@ namespace mediapipe
 
     // Register the calculator to be used in the graph
     REGISTER_CALCULATOR(FaceOrientationCalculator);
+    REGISTER_STATELESS_CALCULATOR(FaceOrientationCalculator);
+    REGISTER_SPARSE_LANDMARK_INDICES(FaceOrientationCalculator, kSparseIndices);
 
     absl::Status FaceOrientationCalculator::GetContract(CalculatorContract* cc)
     {
-        cc->Inputs().Index(0).Set<NormalizedLandmarkList>();
+        if (cc->Inputs().HasTag(kSparseStreamTag))
+        {
+            cc->Inputs().Tag(kSparseStreamTag).Set<SparseLandmarks>();
+        }else
+        {
+            cc->Inputs().Index(0).Set<NormalizedLandmarkList>();
+        }
         cc->Outputs().Index(0).Set<std::map<std::string, double>>();
+        MP_RETURN_IF_ERROR(GatedOutput::SetContract(cc));
         return absl::OkStatus();
     }
 
     absl::Status FaceOrientationCalculator::Open(CalculatorContext* cc)
-    { return absl::OkStatus(); }
+    {
+        cc->SetOffset(TimestampDiff(0));
+        return absl::OkStatus();
+    }
 
     absl::Status FaceOrientationCalculator::Process(CalculatorContext* cc)
     {
-        auto landmarks = cc->Inputs().Index(0).Get<NormalizedLandmarkList>();
+        CALCULATOR_TRACE_SCOPE("FaceOrientationCalculator", cc);
+        MP_RETURN_IF_ERROR(m_gate.Update(cc));
+        if (m_gate.Reemit(cc, cc->Outputs().Index(0))) { return absl::OkStatus(); }
+
         std::map<std::string, double> orientation_map;
-        orientation_map["horizontal_align"]   = landmarks.landmark(1).x();
-        orientation_map["vertical_align"]     = landmarks.landmark(1).y();
+        if (cc->Inputs().HasTag(kSparseStreamTag))
+        {
+            const auto& sparse = cc->Inputs().Tag(kSparseStreamTag).Get<SparseLandmarks>();
+            if (!sparse.HasAll(kSparseIndices))
+            {
+                return absl::InvalidArgumentError("SparseLandmarks lacks the FaceOrientationCalculator landmarks");
+            }
+            const auto nose = sparse.Standardized(kNoseTip);
+            orientation_map["horizontal_align"]   = nose[0];
+            orientation_map["vertical_align"]     = nose[1];
+        }else
+        {
+            const auto& landmarks = cc->Inputs().Index(0).Get<NormalizedLandmarkList>();
+            orientation_map["horizontal_align"]   = landmarks.landmark(kNoseTip).x();
+            orientation_map["vertical_align"]     = landmarks.landmark(kNoseTip).y();
+        }
             
         Packet packet = MakePacket<decltype(orientation_map)>(orientation_map).At(cc->InputTimestamp());
+        m_gate.Remember(cc, packet);
         cc->Outputs().Index(0).AddPacket(packet);
 
         return absl::OkStatus();
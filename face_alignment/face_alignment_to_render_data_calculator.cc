@@ -7,6 +7,12 @@
 #include "mediapipe/framework/formats/landmark.pb.h"
 #include "mediapipe/util/color.pb.h"
 #include "mediapipe/util/render_data.pb.h"
+#include "mediapipe/calculators/custom/util/arena_packet.h"
+#include "mediapipe/calculators/custom/face_alignment/face_alignment_to_render_data_calculator.pb.h"
+#include "mediapipe/calculators/custom/util/calculator_trace.h"
+#include "mediapipe/calculators/custom/util/config_input.h"
+#include "mediapipe/calculators/custom/util/gated_output.h"
+#include "mediapipe/calculators/custom/util/stateless_calculator.h"
 
 namespace mediapipe
 {
@@ -22,6 +28,9 @@ namespace mediapipe
      * 
      * INPUTS:
      *      orientation - orientations (std::vector<std::map<std::string, double> >)
+     *      GATE - (Optional) Recompute when true, else re-emit the previous output (bool)
+     *      CONFIG - (Optional) Replaces the cut-offs from then on
+     *               (OrientationThresholds), see ConfigInput
      * OUTPUTS:
      *      RENDER - Render Data to be render by OverlayRenderer (RenderData)
      * 
@@ -37,6 +46,10 @@ namespace mediapipe
     class FaceOrientationToRenderDataCalculator: public CalculatorBase
     {
     private:
+        GatedOutput m_gate;
+        ConfigInput<OrientationThresholds> m_thresholds;
+        ArenaPool m_arena_pool { kRenderDataArenaBlockSize };
+
         void Annotateorientation(RenderData& render_data, std::string orientation, double left_pos);
     public:
         FaceOrientationToRenderDataCalculator() = default;
@@ -51,16 +64,23 @@ namespace mediapipe
     };
     // Register the calculator to be used in the graph
     REGISTER_CALCULATOR(FaceOrientationToRenderDataCalculator);
+    REGISTER_STATELESS_CALCULATOR(FaceOrientationToRenderDataCalculator);
 
     absl::Status FaceOrientationToRenderDataCalculator::GetContract(CalculatorContract* cc)
     {
         cc->Inputs().Tag(korientationStreamTag).Set<std::vector<std::map<std::string, double> > >();
         cc->Outputs().Tag(kRenderDataStreamTag).Set<RenderData>();
+        MP_RETURN_IF_ERROR(GatedOutput::SetContract(cc));
+        ConfigInput<OrientationThresholds>::SetContract(cc);
         return absl::OkStatus();
     }
 
     absl::Status FaceOrientationToRenderDataCalculator::Open(CalculatorContext* cc)
-    { return absl::OkStatus(); }
+    {
+        m_thresholds.Open(cc->Options<FaceOrientationToRenderDataCalculatorOptions>().thresholds());
+        cc->SetOffset(TimestampDiff(0));
+        return absl::OkStatus();
+    }
 
     void FaceOrientationToRenderDataCalculator::Annotateorientation(RenderData& render_data, std::string orientation, double left_pos)
     {
@@ -89,26 +109,39 @@ namespace mediapipe
 
     absl::Status FaceOrientationToRenderDataCalculator::Process(CalculatorContext* cc)
     {
-        RenderData render_data;
+        CALCULATOR_TRACE_SCOPE("FaceOrientationToRenderDataCalculator", cc);
+        MP_RETURN_IF_ERROR(m_gate.Update(cc));
+        if (m_thresholds.Update(cc))
+        {
+            if (cc->Inputs().Tag(korientationStreamTag).IsEmpty()) { return absl::OkStatus(); }
+        }else if (m_gate.Reemit(cc, cc->Outputs().Tag(kRenderDataStreamTag)))
+        {
+            return absl::OkStatus();
+        }
+
+        auto arena = m_arena_pool.Acquire();
+        auto render_data = google::protobuf::Arena::CreateMessage<RenderData>(arena.get());
         if (!cc->Inputs().Tag(korientationStreamTag).IsEmpty())
         {
             auto multi_face_orientations = cc->Inputs().Tag(korientationStreamTag).Get<std::vector<std::map<std::string, double> > >();
             if(!multi_face_orientations.empty())
             {
                 auto orientation = multi_face_orientations.at(0);
-                std::string hor_align =    orientation.at("horizontal_align") >= 0.3 ? "Right":
-                                            orientation.at("horizontal_align") <= -0.3 ? "Left":
+                const auto& thresholds = m_thresholds.Get();
+                std::string hor_align =    orientation.at("horizontal_align") >= thresholds.right() ? "Right":
+                                            orientation.at("horizontal_align") <= thresholds.left() ? "Left":
                                             "Neutral";
-                std::string ver_align =    orientation.at("vertical_align") >= 0.6 ? "Down":
-                                            orientation.at("vertical_align") <= -0.05 ? "Up":
+                std::string ver_align =    orientation.at("vertical_align") >= thresholds.down() ? "Down":
+                                            orientation.at("vertical_align") <= thresholds.up() ? "Up":
                                             "Neutral";
                 
-                this->Annotateorientation(render_data, hor_align, 0.05);
-                this->Annotateorientation(render_data, ver_align, 0.6);
+                this->Annotateorientation(*render_data, hor_align, 0.05);
+                this->Annotateorientation(*render_data, ver_align, 0.6);
             }
         }
         
-        Packet packet = MakePacket<decltype(render_data)>(render_data).At(cc->InputTimestamp());
+        Packet packet = MakeArenaPacket(render_data, std::move(arena)).At(cc->InputTimestamp());
+        m_gate.Remember(cc, packet);
         cc->Outputs().Tag(kRenderDataStreamTag).AddPacket(packet);
 
         return absl::OkStatus();
@@ -0,0 +1,253 @@
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/port/status.h"
+#include "mediapipe/framework/port/opencv_core_inc.h"
+#include "mediapipe/framework/port/opencv_imgproc_inc.h"
+#include "mediapipe/framework/formats/image_frame.h"
+#include "mediapipe/framework/formats/image_format.pb.h"
+#include "mediapipe/framework/formats/image_frame_opencv.h"
+#include "mediapipe/calculators/custom/face_alignment/orientation_heatmap_calculator.pb.h"
+#include "mediapipe/calculators/custom/util/calculator_trace.h"
+
+namespace mediapipe
+{
+
+    namespace
+    {
+        constexpr char kTickStreamTag[]  = "TICK";
+        constexpr char kImageStreamTag[] = "IMAGE";
+
+        // Palette level of a cell visited once; the bottom of INFERNO is
+        // nearly black and would hide rarely visited cells
+        constexpr int kMinVisitedLevel = 64;
+    } // namespace
+
+    /**
+     * @brief Accumulate face orientations into a session heatmap image
+     *
+     * Keeps a 2D histogram of (horizontal_align, vertical_align) over the whole
+     * stream; each frame increments one cell. The color-mapped canvas, drawn
+     * over a blank `color` image (white when unset), is emitted on a TICK
+     * packet, every `emit_interval` frames and at the end of the stream.
+     *
+     * Cells are colored by count relative to a scale that doubles when the
+     * largest count outgrows it, so an emit only re-colors the cells updated
+     * since the previous one, except on the few frames where the scale grows.
+     *
+     * INPUTS:
+     *      0 - Face orientation data (std::map<std::string, double>)
+     *      TICK - (Optional) Emit the heatmap at this timestamp (any)
+     * OUTPUTS:
+     *      IMAGE - Heatmap (ImageFrame, SRGB)
+     *
+     * Example:
+     *
+     * node {
+     *   calculator: "OrientationHeatmapCalculator"
+     *   input_stream: "face_orientations"
+     *   output_stream: "IMAGE:orientation_heatmap"
+     *   node_options: {
+     *     [type.googleapis.com/mediapipe.OrientationHeatmapCalculatorOptions] {
+     *       color { r: 255 g: 255 b: 255 }
+     *       columns: 60
+     *       rows: 40
+     *     }
+     *   }
+     * }
+     *
+     */
+    class OrientationHeatmapCalculator: public CalculatorBase
+    {
+    private:
+        OrientationHeatmapCalculatorOptions m_options;
+
+        std::vector<uint32_t> m_counts;
+        uint32_t m_scale = 1;
+        bool m_needs_full_recolor = false;
+        std::vector<uint8_t> m_is_dirty;
+        std::vector<int> m_dirty_cells;
+
+        cv::Mat m_canvas;
+        cv::Vec3b m_background;
+        std::vector<cv::Vec3b> m_palette;
+
+        int64_t m_frames = 0;
+        Packet m_last_image;
+        Timestamp m_last_timestamp = Timestamp::Unset();
+
+        int CellOf(double value, double min, double max, int cells) const;
+        void PaintCell(int cell);
+        void Emit(CalculatorContext* cc, Timestamp timestamp);
+
+    public:
+        OrientationHeatmapCalculator() = default;
+        ~OrientationHeatmapCalculator() override = default;
+
+        static absl::Status GetContract(CalculatorContract* cc);
+
+        absl::Status Open(CalculatorContext* cc) override;
+        absl::Status Process(CalculatorContext* cc) override;
+        absl::Status Close(CalculatorContext* cc) override;
+    };
+
+    // Register the calculator to be used in the graph
+    REGISTER_CALCULATOR(OrientationHeatmapCalculator);
+
+    absl::Status OrientationHeatmapCalculator::GetContract(CalculatorContract* cc)
+    {
+        cc->Inputs().Index(0).Set<std::map<std::string, double>>();
+        if (cc->Inputs().HasTag(kTickStreamTag))
+        {
+            cc->Inputs().Tag(kTickStreamTag).SetAny();
+        }
+        cc->Outputs().Tag(kImageStreamTag).Set<ImageFrame>();
+        return absl::OkStatus();
+    }
+
+    absl::Status OrientationHeatmapCalculator::Open(CalculatorContext* cc)
+    {
+        m_options = cc->Options<OrientationHeatmapCalculatorOptions>();
+        if (m_options.columns() <= 0 || m_options.rows() <= 0 ||
+            m_options.width() < m_options.columns() || m_options.height() < m_options.rows())
+        {
+            return absl::InvalidArgumentError("OrientationHeatmapCalculator needs at least one pixel per cell");
+        }
+        if (!(m_options.horizontal_max() > m_options.horizontal_min()) ||
+            !(m_options.vertical_max() > m_options.vertical_min()))
+        {
+            return absl::InvalidArgumentError("OrientationHeatmapCalculator needs non-empty alignment ranges");
+        }
+
+        const int num_cells = m_options.columns() * m_options.rows();
+        m_counts.assign(num_cells, 0);
+        m_is_dirty.assign(num_cells, 0);
+        m_dirty_cells.reserve(num_cells);
+
+        m_background = m_options.has_color() ?
+            cv::Vec3b(m_options.color().r(), m_options.color().g(), m_options.color().b()):
+            cv::Vec3b(255, 255, 255);
+        m_canvas = cv::Mat(m_options.height(), m_options.width(), CV_8UC3, cv::Scalar(m_background));
+
+        // Color map lookup, OpenCV maps are BGR
+        cv::Mat gradient(1, 256, CV_8UC1), colors;
+        for (int i = 0; i < 256; ++i) { gradient.at<uint8_t>(0, i) = i; }
+        cv::applyColorMap(gradient, colors, cv::COLORMAP_INFERNO);
+        m_palette.resize(256);
+        for (int i = 0; i < 256; ++i)
+        {
+            const cv::Vec3b bgr = colors.at<cv::Vec3b>(0, i);
+            m_palette[i] = cv::Vec3b(bgr[2], bgr[1], bgr[0]);
+        }
+        return absl::OkStatus();
+    }
+
+    int OrientationHeatmapCalculator::CellOf(double value, double min, double max, int cells) const
+    {
+        const int cell = static_cast<int>((value - min) / (max - min) * cells);
+        return std::min(std::max(cell, 0), cells - 1);
+    } // CellOf()
+
+    void OrientationHeatmapCalculator::PaintCell(int cell)
+    {
+        const int column = cell % m_options.columns();
+        const int row = cell / m_options.columns();
+        const int x0 = column * m_options.width() / m_options.columns();
+        const int x1 = (column + 1) * m_options.width() / m_options.columns();
+        const int y0 = row * m_options.height() / m_options.rows();
+        const int y1 = (row + 1) * m_options.height() / m_options.rows();
+
+        const uint32_t count = m_counts[cell];
+        cv::Vec3b color = m_background;
+        if (count > 0)
+        {
+            const int level = kMinVisitedLevel +
+                static_cast<int>((255 - kMinVisitedLevel) * static_cast<double>(count) / m_scale);
+            color = m_palette[std::min(level, 255)];
+        }
+        m_canvas(cv::Rect(x0, y0, x1 - x0, y1 - y0)).setTo(cv::Scalar(color));
+    } // PaintCell()
+
+    void OrientationHeatmapCalculator::Emit(CalculatorContext* cc, Timestamp timestamp)
+    {
+        if (m_needs_full_recolor)
+        {
+            for (int cell = 0; cell < static_cast<int>(m_counts.size()); ++cell) { this->PaintCell(cell); }
+            m_needs_full_recolor = false;
+        }else
+        {
+            for (int cell: m_dirty_cells) { this->PaintCell(cell); }
+        }
+
+        // Unchanged since the last emit, share its pixels
+        if (m_dirty_cells.empty() && !m_last_image.IsEmpty())
+        {
+            cc->Outputs().Tag(kImageStreamTag).AddPacket(m_last_image.At(timestamp));
+            return;
+        }
+        for (int cell: m_dirty_cells) { m_is_dirty[cell] = 0; }
+        m_dirty_cells.clear();
+
+        auto frame = absl::make_unique<ImageFrame>(ImageFormat::SRGB, m_options.width(), m_options.height());
+        m_canvas.copyTo(formats::MatView(frame.get()));
+        m_last_image = Adopt(frame.release()).At(timestamp);
+        cc->Outputs().Tag(kImageStreamTag).AddPacket(m_last_image);
+    } // Emit()
+
+    absl::Status OrientationHeatmapCalculator::Process(CalculatorContext* cc)
+    {
+        CALCULATOR_TRACE_SCOPE("OrientationHeatmapCalculator", cc);
+        m_last_timestamp = cc->InputTimestamp();
+
+        bool should_emit = cc->Inputs().HasTag(kTickStreamTag) && !cc->Inputs().Tag(kTickStreamTag).IsEmpty();
+        if (!cc->Inputs().Index(0).IsEmpty())
+        {
+            const auto& orientation = cc->Inputs().Index(0).Get<std::map<std::string, double>>();
+            const int column = this->CellOf(
+                orientation.at("horizontal_align"),
+                m_options.horizontal_min(), m_options.horizontal_max(), m_options.columns()
+            );
+            const int row = this->CellOf(
+                orientation.at("vertical_align"),
+                m_options.vertical_min(), m_options.vertical_max(), m_options.rows()
+            );
+            const int cell = row * m_options.columns() + column;
+
+            if (++m_counts[cell] > m_scale)
+            {
+                m_scale *= 2;
+                m_needs_full_recolor = true;
+            }
+            if (!m_is_dirty[cell])
+            {
+                m_is_dirty[cell] = 1;
+                m_dirty_cells.push_back(cell);
+            }
+
+            ++m_frames;
+            should_emit = should_emit || (m_options.emit_interval() > 0 && m_frames % m_options.emit_interval() == 0);
+        }
+
+        if (should_emit) { this->Emit(cc, cc->InputTimestamp()); }
+
+        return absl::OkStatus();
+    } // Process()
+
+    absl::Status OrientationHeatmapCalculator::Close(CalculatorContext* cc)
+    {
+        if (m_options.emit_on_close() && m_frames > 0)
+        {
+            const Timestamp timestamp = m_last_timestamp.IsRangeValue() ?
+                m_last_timestamp.NextAllowedInStream(): Timestamp::PostStream();
+            // A heatmap already emitted at the last frame is final
+            if (!m_dirty_cells.empty() || m_last_image.IsEmpty()) { this->Emit(cc, timestamp); }
+        }
+        return absl::OkStatus();
+    }
+
+} // namespace mediapipe
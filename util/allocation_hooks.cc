@@ -0,0 +1,70 @@
+// Routes the glibc allocation functions through the allocation profiler's
+// per-thread counters. operator new and std::allocator end up in malloc, so
+// they are counted too. Link only into profiling and test binaries.
+
+#include <cerrno>
+#include <cstddef>
+
+#include "mediapipe/calculators/custom/util/allocation_profiler.h"
+
+extern "C"
+{
+    void* __libc_malloc(size_t size);
+    void* __libc_calloc(size_t count, size_t size);
+    void* __libc_realloc(void* ptr, size_t size);
+    void* __libc_memalign(size_t alignment, size_t size);
+    void __libc_free(void* ptr);
+
+    void* malloc(size_t size)
+    {
+        mediapipe::allocation::internal::CountAllocation(size);
+        return __libc_malloc(size);
+    }
+
+    void* calloc(size_t count, size_t size)
+    {
+        mediapipe::allocation::internal::CountAllocation(count * size);
+        return __libc_calloc(count, size);
+    }
+
+    void* realloc(void* ptr, size_t size)
+    {
+        mediapipe::allocation::internal::CountAllocation(size);
+        return __libc_realloc(ptr, size);
+    }
+
+    void* memalign(size_t alignment, size_t size)
+    {
+        mediapipe::allocation::internal::CountAllocation(size);
+        return __libc_memalign(alignment, size);
+    }
+
+    void* aligned_alloc(size_t alignment, size_t size)
+    {
+        mediapipe::allocation::internal::CountAllocation(size);
+        return __libc_memalign(alignment, size);
+    }
+
+    int posix_memalign(void** ptr, size_t alignment, size_t size)
+    {
+        if (alignment < sizeof(void*) || (alignment & (alignment - 1)) != 0) { return EINVAL; }
+        mediapipe::allocation::internal::CountAllocation(size);
+        void* result = __libc_memalign(alignment, size);
+        if (!result) { return ENOMEM; }
+        *ptr = result;
+        return 0;
+    }
+
+    void free(void* ptr)
+    {
+        __libc_free(ptr);
+    }
+} // extern "C"
+
+namespace
+{
+    const bool g_hooks_registered = [] {
+        mediapipe::allocation::internal::g_hooks_installed.store(true);
+        return true;
+    }();
+} // namespace
@@ -0,0 +1,142 @@
+#include "mediapipe/calculators/custom/util/allocation_profiler.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <set>
+#include <sstream>
+
+namespace mediapipe
+{
+    namespace allocation
+    {
+        namespace
+        {
+            std::atomic<bool> g_assert_allocation_free { false };
+
+            std::mutex& StatsMutex()
+            {
+                static std::mutex* mutex = new std::mutex;
+                return *mutex;
+            }
+
+            std::map<std::string, Stats>& StatsByName()
+            {
+                static auto* stats = new std::map<std::string, Stats>;
+                return *stats;
+            }
+
+            std::set<std::string>& AllocationFreeNames()
+            {
+                static auto* names = new std::set<std::string>;
+                return *names;
+            }
+
+            // Keeps the profiler's own bookkeeping out of the counts
+            class PauseCounting
+            {
+            public:
+                PauseCounting() { ++internal::t_counters.paused; }
+                ~PauseCounting() { --internal::t_counters.paused; }
+            };
+        } // namespace
+
+        namespace internal
+        {
+            std::atomic<bool> g_enabled { false };
+            std::atomic<bool> g_hooks_installed { false };
+            thread_local ThreadCounters t_counters = {0, 0, 0};
+
+            void Record(const char* name, uint64_t allocations, uint64_t bytes)
+            {
+                PauseCounting pause;
+                bool violates = false;
+                {
+                    std::lock_guard<std::mutex> lock(StatsMutex());
+                    auto it = StatsByName().find(name);
+                    if (it == StatsByName().end())
+                    {
+                        it = StatsByName().emplace(name, Stats()).first;
+                        it->second.name = name;
+                        it->second.allocation_free = AllocationFreeNames().count(name) > 0;
+                    }
+                    Stats& stats = it->second;
+                    ++stats.calls;
+                    stats.allocations += allocations;
+                    stats.bytes += bytes;
+                    stats.max_allocations_per_call = std::max(stats.max_allocations_per_call, allocations);
+                    violates = stats.allocation_free && allocations > 0;
+                }
+
+                if (violates && g_assert_allocation_free.load(std::memory_order_relaxed))
+                {
+                    std::fprintf(stderr,
+                        "%s is registered allocation-free but made %llu allocations (%llu bytes) in Process()\n",
+                        name, static_cast<unsigned long long>(allocations), static_cast<unsigned long long>(bytes));
+                    std::abort();
+                }
+            }
+        } // namespace internal
+
+        void Enable(bool assert_allocation_free)
+        {
+            g_assert_allocation_free.store(assert_allocation_free, std::memory_order_relaxed);
+            internal::g_enabled.store(true, std::memory_order_relaxed);
+        }
+
+        void Disable()
+        {
+            internal::g_enabled.store(false, std::memory_order_relaxed);
+        }
+
+        bool HooksInstalled()
+        {
+            return internal::g_hooks_installed.load(std::memory_order_relaxed);
+        }
+
+        void Reset()
+        {
+            PauseCounting pause;
+            std::lock_guard<std::mutex> lock(StatsMutex());
+            StatsByName().clear();
+        }
+
+        std::vector<Stats> Snapshot()
+        {
+            PauseCounting pause;
+            std::vector<Stats> snapshot;
+            std::lock_guard<std::mutex> lock(StatsMutex());
+            snapshot.reserve(StatsByName().size());
+            for (const auto& entry: StatsByName()) { snapshot.push_back(entry.second); }
+            return snapshot;
+        }
+
+        std::string Report()
+        {
+            PauseCounting pause;
+            std::ostringstream out;
+            if (!HooksInstalled()) { out << "(allocation hooks not linked, counts are zero)\n"; }
+            for (const auto& stats: Snapshot())
+            {
+                const double calls = std::max<uint64_t>(stats.calls, 1);
+                out << stats.name << (stats.allocation_free ? " [allocation-free]": "")
+                    << ": " << stats.calls << " calls, "
+                    << stats.allocations / calls << " allocations and "
+                    << stats.bytes / calls << " bytes per call, worst call "
+                    << stats.max_allocations_per_call << " allocations\n";
+            }
+            return out.str();
+        }
+
+        bool MarkAllocationFree(const std::string& name)
+        {
+            PauseCounting pause;
+            std::lock_guard<std::mutex> lock(StatsMutex());
+            auto it = StatsByName().find(name);
+            if (it != StatsByName().end()) { it->second.allocation_free = true; }
+            return AllocationFreeNames().insert(name).second;
+        }
+    } // namespace allocation
+} // namespace mediapipe
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace mediapipe
+{
+    namespace allocation
+    {
+        struct Stats
+        {
+            std::string name;
+            uint64_t calls = 0;
+            uint64_t allocations = 0;
+            uint64_t bytes = 0;
+            uint64_t max_allocations_per_call = 0;
+            bool allocation_free = false;
+        };
+
+        /**
+         * @brief Count heap allocations made inside each calculator's Process()
+         *
+         * Counting needs the :allocation_hooks library linked into the binary,
+         * which routes malloc and friends (and so operator new) through a
+         * per-thread counter; without it every scope reports zero. Scopes are
+         * opened by CALCULATOR_TRACE_SCOPE when built with
+         * MEDIAPIPE_CUSTOM_ALLOCATION_PROFILE, so regular builds pay nothing.
+         *
+         * In assert mode, a calculator declared with
+         * REGISTER_ALLOCATION_FREE_CALCULATOR aborts the process as soon as one
+         * of its Process() calls allocates.
+         */
+        void Enable(bool assert_allocation_free = false);
+        void Disable();
+
+        // False when the hooks library is not linked in
+        bool HooksInstalled();
+
+        void Reset();
+        std::vector<Stats> Snapshot();
+
+        // One line per calculator: calls, allocations and bytes per call, worst call
+        std::string Report();
+
+        bool MarkAllocationFree(const std::string& name);
+
+        namespace internal
+        {
+            extern std::atomic<bool> g_enabled;
+            extern std::atomic<bool> g_hooks_installed;
+
+            struct ThreadCounters
+            {
+                uint64_t allocations;
+                uint64_t bytes;
+                // Non-zero while the profiler itself allocates
+                int paused;
+            };
+            // Constant-initialized, so touching it from malloc never allocates
+            extern thread_local ThreadCounters t_counters;
+
+            inline void CountAllocation(size_t size)
+            {
+                if (t_counters.paused == 0)
+                {
+                    ++t_counters.allocations;
+                    t_counters.bytes += size;
+                }
+            }
+
+            void Record(const char* name, uint64_t allocations, uint64_t bytes);
+        } // namespace internal
+
+        // Attributes the allocations of the enclosing scope to `name`
+        class AllocationScope
+        {
+        private:
+            const char* m_name;
+            bool m_active;
+            uint64_t m_allocations = 0;
+            uint64_t m_bytes = 0;
+
+        public:
+            explicit AllocationScope(const char* name)
+                : m_name(name), m_active(internal::g_enabled.load(std::memory_order_relaxed))
+            {
+                if (m_active)
+                {
+                    m_allocations = internal::t_counters.allocations;
+                    m_bytes = internal::t_counters.bytes;
+                }
+            }
+
+            ~AllocationScope()
+            {
+                if (m_active)
+                {
+                    internal::Record(
+                        m_name,
+                        internal::t_counters.allocations - m_allocations,
+                        internal::t_counters.bytes - m_bytes
+                    );
+                }
+            }
+
+            AllocationScope(const AllocationScope&) = delete;
+            AllocationScope& operator=(const AllocationScope&) = delete;
+        };
+    } // namespace allocation
+} // namespace mediapipe
+
+// Declares that a calculator's Process() must not touch the heap, checked in assert mode
+#define REGISTER_ALLOCATION_FREE_CALCULATOR(name)                      \
+    static const bool allocation_free_calculator_registered_##name =   \
+        ::mediapipe::allocation::MarkAllocationFree(#name)
@@ -0,0 +1,151 @@
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/calculator_runner.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/status_matchers.h"
+#include "mediapipe/calculators/custom/util/allocation_profiler.h"
+#include "mediapipe/calculators/custom/util/calculator_trace.h"
+
+// Built with MEDIAPIPE_CUSTOM_ALLOCATION_PROFILE and linked with
+// :allocation_hooks, see the BUILD rule
+namespace mediapipe
+{
+
+    namespace
+    {
+        constexpr int kNumPackets = 5;
+        constexpr size_t kBufferSize = 256;
+
+        // Keeps a heap copy of every input
+        class HeapCopyCalculator: public CalculatorBase
+        {
+        private:
+            std::vector<std::unique_ptr<std::vector<int>>> m_copies;
+
+        public:
+            static absl::Status GetContract(CalculatorContract* cc)
+            {
+                cc->Inputs().Index(0).Set<int>();
+                return absl::OkStatus();
+            }
+
+            absl::Status Process(CalculatorContext* cc) override
+            {
+                CALCULATOR_TRACE_SCOPE("HeapCopyCalculator", cc);
+                const int value = cc->Inputs().Index(0).Get<int>();
+                m_copies.push_back(std::make_unique<std::vector<int>>(kBufferSize, value));
+                return absl::OkStatus();
+            }
+        };
+
+        // Same as HeapCopyCalculator, wrongly declared allocation-free
+        class MisdeclaredCalculator: public HeapCopyCalculator
+        {
+        public:
+            absl::Status Process(CalculatorContext* cc) override
+            {
+                CALCULATOR_TRACE_SCOPE("MisdeclaredCalculator", cc);
+                return HeapCopyCalculator::Process(cc);
+            }
+        };
+
+        // Sums its inputs without touching the heap
+        class SumCalculator: public CalculatorBase
+        {
+        private:
+            int64_t m_sum = 0;
+
+        public:
+            static absl::Status GetContract(CalculatorContract* cc)
+            {
+                cc->Inputs().Index(0).Set<int>();
+                return absl::OkStatus();
+            }
+
+            absl::Status Process(CalculatorContext* cc) override
+            {
+                CALCULATOR_TRACE_SCOPE("SumCalculator", cc);
+                m_sum += cc->Inputs().Index(0).Get<int>();
+                return absl::OkStatus();
+            }
+        };
+
+        REGISTER_CALCULATOR(HeapCopyCalculator);
+        REGISTER_CALCULATOR(MisdeclaredCalculator);
+        REGISTER_ALLOCATION_FREE_CALCULATOR(MisdeclaredCalculator);
+        REGISTER_CALCULATOR(SumCalculator);
+        REGISTER_ALLOCATION_FREE_CALCULATOR(SumCalculator);
+
+        absl::Status Run(const std::string& calculator)
+        {
+            CalculatorGraphConfig::Node node;
+            node.set_calculator(calculator);
+            node.add_input_stream("in");
+            CalculatorRunner runner(node);
+            for (int i = 0; i < kNumPackets; ++i)
+            {
+                runner.MutableInputs()->Index(0).packets.push_back(MakePacket<int>(i).At(Timestamp(i)));
+            }
+            return runner.Run();
+        }
+
+        allocation::Stats StatsOf(const std::string& name)
+        {
+            for (const auto& stats: allocation::Snapshot())
+            {
+                if (stats.name == name) { return stats; }
+            }
+            return allocation::Stats();
+        }
+    } // namespace
+
+    TEST(AllocationProfilerTest, HooksAreLinked)
+    {
+        EXPECT_TRUE(allocation::HooksInstalled());
+    }
+
+    TEST(AllocationProfilerTest, CountsAllocationsOfProcess)
+    {
+        allocation::Reset();
+        allocation::Enable();
+        MP_ASSERT_OK(Run("HeapCopyCalculator"));
+        allocation::Disable();
+
+        const auto stats = StatsOf("HeapCopyCalculator");
+        EXPECT_EQ(stats.calls, static_cast<uint64_t>(kNumPackets));
+        EXPECT_GE(stats.allocations, static_cast<uint64_t>(2 * kNumPackets));
+        EXPECT_GE(stats.bytes, kNumPackets * kBufferSize * sizeof(int));
+        EXPECT_GE(stats.max_allocations_per_call, 2u);
+        EXPECT_FALSE(stats.allocation_free);
+    }
+
+    TEST(AllocationProfilerTest, TracingIsNotChargedToTheCalculator)
+    {
+        // The first span of each thread allocates its trace buffer, which
+        // would abort here if it were counted against SumCalculator
+        allocation::Reset();
+        allocation::Enable(/*assert_allocation_free=*/true);
+        trace::Enable();
+        MP_ASSERT_OK(Run("SumCalculator"));
+        trace::Disable();
+        allocation::Disable();
+
+        const auto stats = StatsOf("SumCalculator");
+        EXPECT_EQ(stats.calls, static_cast<uint64_t>(kNumPackets));
+        EXPECT_EQ(stats.allocations, 0u);
+        EXPECT_TRUE(stats.allocation_free);
+    }
+
+    TEST(AllocationProfilerDeathTest, AbortsWhenAllocationFreeCalculatorAllocates)
+    {
+        EXPECT_DEATH({
+            allocation::Enable(/*assert_allocation_free=*/true);
+            Run("MisdeclaredCalculator").IgnoreError();
+        }, "MisdeclaredCalculator is registered allocation-free");
+    }
+
+} // namespace mediapipe
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "google/protobuf/arena.h"
+#include "mediapipe/framework/packet.h"
+
+namespace mediapipe
+{
+
+    // Arena block size of the *ToRenderData calculators, enough for the few
+    // text annotations they emit per frame
+    constexpr size_t kRenderDataArenaBlockSize = 4096;
+
+    /**
+     * @brief Wrap an arena-allocated message into a Packet
+     *
+     * The packet points to the message as foreign data and shares ownership
+     * of the arena, so the message stays valid for as long as any copy of the
+     * packet exists. Packet::Consume() refuses foreign data, so consumers
+     * that modify their input in place fall back to copying it.
+     */
+    template <typename T>
+    Packet MakeArenaPacket(const T* message, std::shared_ptr<google::protobuf::Arena> arena)
+    {
+        // The message itself is never deleted, releasing the arena frees it
+        return PointToForeign(message, [arena = std::move(arena)]() {});
+    }
+
+    /**
+     * @brief Per-calculator pool of protobuf arenas for output messages
+     *
+     * An arena is handed out again, after a Reset(), only once every packet
+     * built on it has been released downstream. When all pooled arenas are
+     * still in flight, a new one is added up to max_arenas; past that a
+     * one-off arena is returned.
+     *
+     * Not thread-safe; meant to be owned by a single calculator instance.
+     */
+    class ArenaPool
+    {
+    private:
+        google::protobuf::ArenaOptions m_options;
+        size_t m_max_arenas;
+        std::vector<std::shared_ptr<google::protobuf::Arena>> m_arenas;
+
+    public:
+        explicit ArenaPool(size_t block_size, size_t max_arenas = 8)
+            : m_max_arenas(max_arenas)
+        {
+            m_options.start_block_size = block_size;
+            m_options.max_block_size = block_size;
+            m_arenas.reserve(max_arenas);
+        }
+
+        std::shared_ptr<google::protobuf::Arena> Acquire()
+        {
+            for (auto& arena: m_arenas)
+            {
+                if (arena.use_count() == 1)
+                {
+                    // Pairs with the release of the last downstream reference
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    arena->Reset();
+                    return arena;
+                }
+            }
+            auto arena = std::make_shared<google::protobuf::Arena>(m_options);
+            if (m_arenas.size() < m_max_arenas) { m_arenas.push_back(arena); }
+            return arena;
+        }
+    };
+
+} // namespace mediapipe
@@ -0,0 +1,102 @@
+#include <array>
+#include <memory>
+
+#include "google/protobuf/arena.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/calculator_runner.h"
+#include "mediapipe/framework/formats/landmark.pb.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/status_matchers.h"
+#include "mediapipe/calculators/custom/util/arena_packet.h"
+
+namespace mediapipe
+{
+
+    namespace
+    {
+        constexpr int kNumLandmarks = 4;
+        constexpr size_t kBlockSize = 1024;
+
+        NormalizedLandmarkList* MakeLandmarks(google::protobuf::Arena* arena)
+        {
+            auto* landmarks = google::protobuf::Arena::CreateMessage<NormalizedLandmarkList>(arena);
+            for (int i = 0; i < kNumLandmarks; ++i)
+            {
+                auto* landmark = landmarks->add_landmark();
+                landmark->set_x(0.1f * i);
+                landmark->set_y(0.2f * i);
+                landmark->set_z(0.3f * i);
+            }
+            return landmarks;
+        }
+    } // namespace
+
+    TEST(ArenaPacketTest, ConsumeRefusesArenaMessages)
+    {
+        ArenaPool pool(kBlockSize);
+        auto arena = pool.Acquire();
+        const NormalizedLandmarkList* landmarks = MakeLandmarks(arena.get());
+        Packet packet = MakeArenaPacket(landmarks, std::move(arena));
+
+        EXPECT_FALSE(packet.Consume<NormalizedLandmarkList>().ok());
+        // Still readable, and still the arena message
+        EXPECT_EQ(&packet.Get<NormalizedLandmarkList>(), landmarks);
+        EXPECT_EQ(packet.Get<NormalizedLandmarkList>().landmark_size(), kNumLandmarks);
+    }
+
+    TEST(ArenaPacketTest, PoolReusesArenaOnlyAfterLastPacketIsReleased)
+    {
+        ArenaPool pool(kBlockSize, /*max_arenas=*/1);
+        auto arena = pool.Acquire();
+        google::protobuf::Arena* first = arena.get();
+        Packet packet = MakeArenaPacket(MakeLandmarks(arena.get()), std::move(arena));
+        Packet copy = packet.At(Timestamp(1));
+
+        // In flight: a one-off arena is handed out instead
+        EXPECT_NE(pool.Acquire().get(), first);
+        packet = Packet();
+        EXPECT_NE(pool.Acquire().get(), first);
+        EXPECT_EQ(copy.Get<NormalizedLandmarkList>().landmark_size(), kNumLandmarks);
+
+        copy = Packet();
+        EXPECT_EQ(pool.Acquire().get(), first);
+    }
+
+    TEST(ArenaPacketTest, InPlaceConsumerCopiesArenaInput)
+    {
+        CalculatorRunner runner(R"pb(
+            calculator: "LandmarkTransformCalculator"
+            input_stream: "LANDMARKS:landmarks"
+            input_side_packet: "MATRIX:matrix"
+            output_stream: "LANDMARKS:transformed"
+        )pb");
+        // Translates x by one
+        runner.MutableSidePackets()->Tag("MATRIX") = MakePacket<std::array<float, 16>>(std::array<float, 16> {
+            1, 0, 0, 1,
+            0, 1, 0, 0,
+            0, 0, 1, 0,
+            0, 0, 0, 1,
+        });
+
+        ArenaPool pool(kBlockSize);
+        auto arena = pool.Acquire();
+        const NormalizedLandmarkList* landmarks = MakeLandmarks(arena.get());
+        runner.MutableInputs()->Tag("LANDMARKS").packets.push_back(
+            MakeArenaPacket(landmarks, std::move(arena)).At(Timestamp(0))
+        );
+        MP_ASSERT_OK(runner.Run());
+
+        const auto& outputs = runner.Outputs().Tag("LANDMARKS").packets;
+        ASSERT_EQ(outputs.size(), 1u);
+        const auto& transformed = outputs[0].Get<NormalizedLandmarkList>();
+        EXPECT_NE(&transformed, landmarks);
+        ASSERT_EQ(transformed.landmark_size(), kNumLandmarks);
+        for (int i = 0; i < kNumLandmarks; ++i)
+        {
+            EXPECT_FLOAT_EQ(transformed.landmark(i).x(), 0.1f * i + 1.0f);
+            // The arena message is left untouched
+            EXPECT_FLOAT_EQ(landmarks->landmark(i).x(), 0.1f * i);
+        }
+    }
+
+} // namespace mediapipe
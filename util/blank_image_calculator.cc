@@ -7,6 +7,7 @@
 #include "mediapipe/framework/formats/image_frame_opencv.h"
 #include "mediapipe/framework/timestamp.h"
 #include "mediapipe/calculators/custom/util/blank_image_calculator.pb.h"
+#include "mediapipe/calculators/custom/util/calculator_trace.h"
 
 namespace {
 // Maps ImageFrame format to OpenCV Mat type.
@@ -125,6 +126,7 @@ namespace mediapipe
 
     absl::Status BlankImageCalculator::Process(CalculatorContext* cc)
     {
+        CALCULATOR_TRACE_SCOPE("BlankImageCalculator", cc);
         cv::Vec3b color(
             m_options.color().r(),
             m_options.color().g(),
@@ -0,0 +1,250 @@
+#include "mediapipe/calculators/custom/util/calculator_trace.h"
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace mediapipe
+{
+    namespace trace
+    {
+        namespace
+        {
+            constexpr uint64_t kBufferCapacity = 1 << 14;
+            // Buffers of exited threads kept for the next WriteChromeTrace()
+            constexpr size_t kMaxExitedBuffers = 8;
+
+            struct Span
+            {
+                // index + 1 once the span is complete, 0 while being written
+                std::atomic<uint64_t> version { 0 };
+                const char* name = nullptr;
+                int64_t packet_timestamp = 0;
+                int64_t begin_ns = 0;
+                int64_t end_ns = 0;
+            };
+
+            // Ring of the most recent spans of one thread; written only by its owner
+            struct ThreadBuffer
+            {
+                int64_t tid;
+                std::atomic<uint64_t> head { 0 };
+                std::atomic<bool> exited { false };
+                std::unique_ptr<Span[]> spans { new Span[kBufferCapacity] };
+            };
+
+            std::mutex& RegistryMutex()
+            {
+                static std::mutex* mutex = new std::mutex;
+                return *mutex;
+            }
+
+            std::vector<std::shared_ptr<ThreadBuffer>>& Registry()
+            {
+                static auto* registry = new std::vector<std::shared_ptr<ThreadBuffer>>;
+                return *registry;
+            }
+
+            // Drops the oldest buffers of exited threads beyond kMaxExitedBuffers
+            void TrimExitedBuffers(std::vector<std::shared_ptr<ThreadBuffer>>& registry)
+            {
+                size_t exited = std::count_if(registry.begin(), registry.end(),
+                    [](const auto& buffer) { return buffer->exited.load(std::memory_order_acquire); });
+                for (auto it = registry.begin(); it != registry.end() && exited > kMaxExitedBuffers;)
+                {
+                    if ((*it)->exited.load(std::memory_order_acquire))
+                    {
+                        it = registry.erase(it);
+                        --exited;
+                    }else
+                    {
+                        ++it;
+                    }
+                }
+            }
+
+            // Marks the thread's buffer exited when the thread ends
+            struct ThreadBufferOwner
+            {
+                std::shared_ptr<ThreadBuffer> buffer;
+
+                ThreadBufferOwner()
+                    : buffer(std::make_shared<ThreadBuffer>())
+                {
+                    buffer->tid = static_cast<int64_t>(syscall(SYS_gettid));
+                    std::lock_guard<std::mutex> lock(RegistryMutex());
+                    TrimExitedBuffers(Registry());
+                    Registry().push_back(buffer);
+                }
+
+                ~ThreadBufferOwner() { buffer->exited.store(true, std::memory_order_release); }
+            };
+
+            // Registered once per thread; after the thread exits its buffer is
+            // kept until written out, up to kMaxExitedBuffers of them
+            ThreadBuffer* CurrentThreadBuffer()
+            {
+                thread_local ThreadBufferOwner owner;
+                return owner.buffer.get();
+            }
+
+            struct SpanCopy
+            {
+                const char* name;
+                int64_t packet_timestamp;
+                int64_t begin_ns;
+                int64_t end_ns;
+                int64_t tid;
+            };
+
+            // Chrome trace timestamps are microseconds with a fractional part
+            std::ostream& WriteMicros(std::ostream& out, int64_t ns)
+            {
+                return out << ns / 1000 << "." << (ns % 1000) / 100;
+            }
+
+            uint64_t Mix(uint64_t value)
+            {
+                // splitmix64 finalizer, spreads evenly spaced frame timestamps
+                value += 0x9e3779b97f4a7c15ULL;
+                value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+                value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+                return value ^ (value >> 31);
+            }
+        } // namespace
+
+        namespace internal
+        {
+            std::atomic<uint64_t> g_sample_every { 0 };
+
+            bool IsSampled(int64_t packet_timestamp)
+            {
+                const uint64_t every = g_sample_every.load(std::memory_order_relaxed);
+                return every == 1 || (every > 1 && Mix(static_cast<uint64_t>(packet_timestamp)) % every == 0);
+            }
+
+            void Record(const char* name, int64_t packet_timestamp, int64_t begin_ns, int64_t end_ns)
+            {
+                ThreadBuffer* buffer = CurrentThreadBuffer();
+                const uint64_t index = buffer->head.load(std::memory_order_relaxed);
+                Span& span = buffer->spans[index % kBufferCapacity];
+
+                span.version.store(0, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+                span.name = name;
+                span.packet_timestamp = packet_timestamp;
+                span.begin_ns = begin_ns;
+                span.end_ns = end_ns;
+                span.version.store(index + 1, std::memory_order_release);
+                buffer->head.store(index + 1, std::memory_order_release);
+            }
+        } // namespace internal
+
+        void Enable(int sample_every)
+        {
+            internal::g_sample_every.store(sample_every > 0 ? sample_every: 1, std::memory_order_relaxed);
+        }
+
+        void Disable()
+        {
+            internal::g_sample_every.store(0, std::memory_order_relaxed);
+        }
+
+        absl::Status WriteChromeTrace(const std::string& path)
+        {
+            std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+            {
+                std::lock_guard<std::mutex> lock(RegistryMutex());
+                buffers = Registry();
+                // Exited threads record nothing more, this is their last write
+                auto& registry = Registry();
+                registry.erase(std::remove_if(registry.begin(), registry.end(),
+                    [](const auto& buffer) { return buffer->exited.load(std::memory_order_acquire); }),
+                    registry.end());
+            }
+
+            std::vector<SpanCopy> spans;
+            for (const auto& buffer: buffers)
+            {
+                const uint64_t head = buffer->head.load(std::memory_order_acquire);
+                const uint64_t begin = head > kBufferCapacity ? head - kBufferCapacity: 0;
+                for (uint64_t index = begin; index < head; ++index)
+                {
+                    const Span& span = buffer->spans[index % kBufferCapacity];
+                    if (span.version.load(std::memory_order_acquire) != index + 1) { continue; }
+                    SpanCopy copy { span.name, span.packet_timestamp, span.begin_ns, span.end_ns, buffer->tid };
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    // Skip spans overwritten while being copied
+                    if (span.version.load(std::memory_order_relaxed) != index + 1) { continue; }
+                    spans.push_back(copy);
+                }
+            }
+
+            // Spans of each packet in the order they ran
+            std::map<int64_t, std::vector<const SpanCopy*>> packets;
+            for (const auto& span: spans) { packets[span.packet_timestamp].push_back(&span); }
+            for (auto& packet: packets)
+            {
+                std::sort(packet.second.begin(), packet.second.end(),
+                          [](const SpanCopy* a, const SpanCopy* b) { return a->begin_ns < b->begin_ns; });
+            }
+
+            std::ofstream out(path);
+            if (!out) { return absl::UnavailableError("Cannot open trace file " + path); }
+
+            const int64_t pid = getpid();
+            bool first = true;
+            out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+            for (const auto& span: spans)
+            {
+                out << (first ? "": ",") << "\n{\"name\":\"" << span.name
+                    << "\",\"cat\":\"calculator\",\"ph\":\"X\",\"ts\":";
+                WriteMicros(out, span.begin_ns) << ",\"dur\":";
+                WriteMicros(out, span.end_ns - span.begin_ns)
+                    << ",\"pid\":" << pid << ",\"tid\":" << span.tid
+                    << ",\"args\":{\"packet_timestamp\":" << span.packet_timestamp << "}}";
+                first = false;
+            }
+
+            // Per packet, an async span from the first calculator entry to the
+            // last exit gives the end-to-end latency, and flow arrows link the
+            // calculator spans the packet went through
+            for (const auto& packet: packets)
+            {
+                const auto& chain = packet.second;
+                int64_t end_ns = chain.front()->end_ns;
+                for (const SpanCopy* span: chain) { end_ns = std::max(end_ns, span->end_ns); }
+
+                out << ",\n{\"name\":\"packet\",\"cat\":\"latency\",\"ph\":\"b\",\"id\":" << packet.first
+                    << ",\"ts\":";
+                WriteMicros(out, chain.front()->begin_ns) << ",\"pid\":" << pid << ",\"tid\":" << chain.front()->tid
+                    << ",\"args\":{\"packet_timestamp\":" << packet.first
+                    << ",\"latency_us\":" << (end_ns - chain.front()->begin_ns) / 1000 << "}}";
+                out << ",\n{\"name\":\"packet\",\"cat\":\"latency\",\"ph\":\"e\",\"id\":" << packet.first
+                    << ",\"ts\":";
+                WriteMicros(out, end_ns) << ",\"pid\":" << pid << ",\"tid\":" << chain.front()->tid << "}";
+
+                if (chain.size() < 2) { continue; }
+                for (size_t i = 0; i < chain.size(); ++i)
+                {
+                    const char* phase = i == 0 ? "s": i + 1 == chain.size() ? "f": "t";
+                    out << ",\n{\"name\":\"packet\",\"cat\":\"flow\",\"ph\":\"" << phase
+                        << "\",\"id\":" << packet.first << ",\"ts\":";
+                    WriteMicros(out, chain[i]->begin_ns) << ",\"pid\":" << pid << ",\"tid\":" << chain[i]->tid
+                        << (i + 1 == chain.size() ? ",\"bp\":\"e\"}": "}");
+                }
+            }
+            out << "\n]}\n";
+
+            if (!out) { return absl::DataLossError("Failed writing trace file " + path); }
+            return absl::OkStatus();
+        } // WriteChromeTrace()
+
+    } // namespace trace
+} // namespace mediapipe
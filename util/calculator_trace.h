@@ -0,0 +1,104 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include "absl/status/status.h"
+
+namespace mediapipe
+{
+    namespace trace
+    {
+        /**
+         * @brief Enable span recording for one packet timestamp in every `sample_every`
+         *
+         * Sampling is decided from the packet timestamp alone, so a sampled frame is
+         * traced through every calculator it passes and the spans line up end to end.
+         */
+        void Enable(int sample_every = 1);
+        void Disable();
+
+        namespace internal
+        {
+            extern std::atomic<uint64_t> g_sample_every;   // 0 when disabled
+
+            bool IsSampled(int64_t packet_timestamp);
+            void Record(const char* name, int64_t packet_timestamp, int64_t begin_ns, int64_t end_ns);
+
+            inline int64_t NowNanos()
+            {
+                return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()
+                ).count();
+            }
+        } // namespace internal
+
+        /**
+         * @brief Write every recorded span as Chrome trace event JSON
+         *
+         * The file opens in Perfetto or chrome://tracing. Besides the calculator
+         * spans, each packet timestamp gets an async "packet" span from its first
+         * calculator entry to its last exit, carrying the end-to-end latency, and
+         * flow arrows linking the calculators it went through.
+         *
+         * Spans keep being recorded while writing; each thread's buffer (about
+         * 650KB) only holds its most recent spans. Buffers of exited threads are
+         * released once written, and at most 8 of them are kept until then.
+         */
+        absl::Status WriteChromeTrace(const std::string& path);
+
+        // Records one enter/exit span keyed by packet timestamp into the calling
+        // thread's buffer, without taking any lock.
+        class TraceScope
+        {
+        private:
+            const char* m_name;
+            int64_t m_packet_timestamp;
+            int64_t m_begin_ns = 0;
+
+        public:
+            TraceScope(const char* name, int64_t packet_timestamp)
+                : m_name(name), m_packet_timestamp(packet_timestamp)
+            {
+                if (internal::g_sample_every.load(std::memory_order_relaxed) != 0 &&
+                    internal::IsSampled(packet_timestamp))
+                {
+                    m_begin_ns = internal::NowNanos();
+                }
+            }
+
+            ~TraceScope()
+            {
+                if (m_begin_ns != 0)
+                {
+                    internal::Record(m_name, m_packet_timestamp, m_begin_ns, internal::NowNanos());
+                }
+            }
+
+            TraceScope(const TraceScope&) = delete;
+            TraceScope& operator=(const TraceScope&) = delete;
+        };
+    } // namespace trace
+} // namespace mediapipe
+
+// Counts heap allocations of the same scope, see allocation_profiler.h
+#ifdef MEDIAPIPE_CUSTOM_ALLOCATION_PROFILE
+#include "mediapipe/calculators/custom/util/allocation_profiler.h"
+#define CALCULATOR_ALLOCATION_SCOPE(name) \
+    ::mediapipe::allocation::AllocationScope calculator_allocation_scope_(name)
+#else
+#define CALCULATOR_ALLOCATION_SCOPE(name)
+#endif
+
+// Traces the rest of the enclosing scope, usually a calculator's Process().
+// The allocation scope is opened inside the trace scope and so closes first,
+// keeping the trace's own buffer allocations out of the calculator's counts.
+#ifdef MEDIAPIPE_CUSTOM_DISABLE_TRACE
+#define CALCULATOR_TRACE_SCOPE(name, cc) CALCULATOR_ALLOCATION_SCOPE(name)
+#else
+#define CALCULATOR_TRACE_SCOPE(name, cc) \
+    ::mediapipe::trace::TraceScope calculator_trace_scope_((name), (cc)->InputTimestamp().Value()); \
+    CALCULATOR_ALLOCATION_SCOPE(name)
+#endif
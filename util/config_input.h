@@ -0,0 +1,58 @@
+#pragma once
+
+#include "mediapipe/framework/calculator_framework.h"
+
+namespace mediapipe
+{
+
+    /**
+     * @brief Parameters from node options, replaceable through a CONFIG input
+     *
+     * CONFIG is an optional input stream carrying a whole parameter message.
+     * A packet replaces the current parameters by value between two frames,
+     * so a frame never sees a mix of old and new values, and scalar-only
+     * messages are copied without allocating.
+     *
+     * CONFIG is usually sparse; put it in its own sync set so frames are not
+     * held back waiting for it:
+     *
+     *   input_stream_handler {
+     *     input_stream_handler: "SyncSetInputStreamHandler"
+     *     options {
+     *       [mediapipe.SyncSetInputStreamHandlerOptions.ext] {
+     *         sync_set { tag_index: "CONFIG" }
+     *       }
+     *     }
+     *   }
+     *
+     * Each instance keeps its own copy, which makes the calculator stateful;
+     * ParallelStageSubgraph rejects a CONFIG input for that reason.
+     */
+    template <typename Config>
+    class ConfigInput
+    {
+    private:
+        Config m_config;
+
+    public:
+        static constexpr char kConfigTag[] = "CONFIG";
+
+        static void SetContract(CalculatorContract* cc)
+        {
+            if (cc->Inputs().HasTag(kConfigTag)) { cc->Inputs().Tag(kConfigTag).Set<Config>(); }
+        }
+
+        void Open(const Config& config) { m_config.CopyFrom(config); }
+
+        // Applies a CONFIG packet at the current timestamp, returns true if one arrived
+        bool Update(CalculatorContext* cc)
+        {
+            if (!cc->Inputs().HasTag(kConfigTag) || cc->Inputs().Tag(kConfigTag).IsEmpty()) { return false; }
+            m_config.CopyFrom(cc->Inputs().Tag(kConfigTag).Get<Config>());
+            return true;
+        }
+
+        const Config& Get() const { return m_config; }
+    };
+
+} // namespace mediapipe
@@ -4,6 +4,7 @@
 #include "mediapipe/framework/calculator_framework.h"
 #include "mediapipe/framework/port/status.h"
 #include "mediapipe/calculators/custom/util/constant_matrix_calculator.pb.h"
+#include "mediapipe/calculators/custom/util/calculator_trace.h"
 
 namespace mediapipe
 {
@@ -67,6 +68,7 @@ namespace mediapipe
 
     absl::Status ConstantMatrixCalculator::Process(CalculatorContext* cc)
     {
+        CALCULATOR_TRACE_SCOPE("ConstantMatrixCalculator", cc);
         auto values = m_options.values().data();
         auto matrix = std::make_unique<std::array<float, 16>>();
         std::copy(values, values + 16, matrix->data());
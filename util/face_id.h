@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/calculators/custom/util/frame_interval.h"
+
+namespace mediapipe
+{
+
+    /**
+     * @brief Optional FACE_ID input keying per-face state
+     *
+     * Stateful calculators inside a multi-face BeginLoop/EndLoop graph take
+     * the id of the current face from FaceTrackerCalculator and keep their
+     * history per id in a FaceStateMap. Without the input every packet belongs
+     * to face 0, which is the single-face behaviour. A connected input with no
+     * packet is an error, mixing that frame into face 0 would corrupt its state.
+     *
+     * FACE_ID requires the TIMESTAMP input of FrameInterval: inside the loop
+     * the input timestamp is an item index, which would make expiry and
+     * per-second rates meaningless.
+     *
+     * Per-face state unused for `kDefaultTimeoutMs` is expired, the default of
+     * FaceTrackerCalculator's timeout_ms after which the id is never reused.
+     */
+    struct FaceId
+    {
+        static constexpr char kFaceIdTag[] = "FACE_ID";
+        static constexpr int64_t kDefaultTimeoutMs = 1000;
+
+        static absl::Status SetContract(CalculatorContract* cc)
+        {
+            if (!cc->Inputs().HasTag(kFaceIdTag)) { return absl::OkStatus(); }
+            if (!cc->Inputs().HasTag(FrameInterval::kTimestampTag))
+            {
+                return absl::InvalidArgumentError(absl::StrCat(
+                    "FACE_ID needs the frame timestamp cloned into the loop as ",
+                    FrameInterval::kTimestampTag, ", see FrameInterval"
+                ));
+            }
+            cc->Inputs().Tag(kFaceIdTag).Set<int>();
+            return absl::OkStatus();
+        }
+
+        static absl::StatusOr<int> Of(CalculatorContext* cc)
+        {
+            if (!cc->Inputs().HasTag(kFaceIdTag)) { return 0; }
+            if (cc->Inputs().Tag(kFaceIdTag).IsEmpty())
+            {
+                return absl::InvalidArgumentError(absl::StrCat(
+                    "FACE_ID is connected but empty at ", cc->InputTimestamp().DebugString()
+                ));
+            }
+            return cc->Inputs().Tag(kFaceIdTag).Get<int>();
+        }
+    };
+
+} // namespace mediapipe
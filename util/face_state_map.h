@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace mediapipe
+{
+
+    /**
+     * @brief Fixed-capacity flat map from face id to per-face state
+     *
+     * Entries live in one preallocated array and are found by a linear scan,
+     * which beats hashing for the handful of faces a camera sees. When the map
+     * is full, the least recently used entry is reset and reused. Entries not
+     * used for `timeout` (in the caller's time unit) can be expired explicitly.
+     *
+     * State must be default constructible; a reused entry is reset to State().
+     */
+    template <typename State>
+    class FaceStateMap
+    {
+    private:
+        struct Entry
+        {
+            int id = kNoFace;
+            int64_t last_used = 0;
+            uint64_t use_order = 0;
+            State state {};
+        };
+
+        std::vector<Entry> m_entries;
+        uint64_t m_use_counter = 0;
+
+    public:
+        static constexpr int kNoFace = std::numeric_limits<int>::min();
+        static constexpr size_t kDefaultCapacity = 16;
+
+        explicit FaceStateMap(size_t capacity = kDefaultCapacity)
+            : m_entries(capacity > 0 ? capacity: 1)
+        {}
+
+        // Returns the state of `id`, creating it when missing; `is_new` tells
+        // whether the returned state was just reset
+        State& Get(int id, int64_t now, bool* is_new = nullptr)
+        {
+            Entry* victim = &m_entries[0];
+            for (auto& entry: m_entries)
+            {
+                if (entry.id == id)
+                {
+                    entry.last_used = now;
+                    entry.use_order = ++m_use_counter;
+                    if (is_new) { *is_new = false; }
+                    return entry.state;
+                }
+                // Prefer a free entry, then the least recently used one
+                if (victim->id != kNoFace && (entry.id == kNoFace || entry.use_order < victim->use_order))
+                {
+                    victim = &entry;
+                }
+            }
+
+            victim->id = id;
+            victim->last_used = now;
+            victim->use_order = ++m_use_counter;
+            victim->state = State();
+            if (is_new) { *is_new = true; }
+            return victim->state;
+        }
+
+        State* Find(int id)
+        {
+            for (auto& entry: m_entries)
+            {
+                if (entry.id == id) { return &entry.state; }
+            }
+            return nullptr;
+        }
+
+        // Drops every entry last used before `now - timeout`
+        void Expire(int64_t now, int64_t timeout)
+        {
+            for (auto& entry: m_entries)
+            {
+                if (entry.id != kNoFace && now - entry.last_used > timeout)
+                {
+                    entry.id = kNoFace;
+                    entry.state = State();
+                }
+            }
+        }
+
+        // Visits every live entry as fn(id, state)
+        template <typename Fn>
+        void ForEach(Fn&& fn)
+        {
+            for (auto& entry: m_entries)
+            {
+                if (entry.id != kNoFace) { fn(entry.id, entry.state); }
+            }
+        }
+
+        size_t Capacity() const { return m_entries.size(); }
+    };
+
+} // namespace mediapipe
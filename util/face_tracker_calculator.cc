@@ -0,0 +1,208 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/port/status.h"
+#include "mediapipe/framework/formats/landmark.pb.h"
+#include "mediapipe/calculators/core/begin_loop_calculator.h"
+#include "mediapipe/calculators/custom/util/face_state_map.h"
+#include "mediapipe/calculators/custom/util/face_tracker_calculator.pb.h"
+#include "mediapipe/calculators/custom/util/calculator_trace.h"
+
+namespace mediapipe
+{
+
+    namespace
+    {
+        constexpr char kIdsStreamTag[]       = "IDS";
+        constexpr char kTimestampStreamTag[] = "TIMESTAMP";
+
+        struct FaceBox
+        {
+            float cx = 0.0f;
+            float cy = 0.0f;
+            float width = 0.0f;
+            float height = 0.0f;
+        };
+
+        FaceBox BoxOf(const NormalizedLandmarkList& landmarks)
+        {
+            FaceBox box;
+            if (landmarks.landmark_size() == 0) { return box; }
+            float min_x = landmarks.landmark(0).x(), max_x = min_x;
+            float min_y = landmarks.landmark(0).y(), max_y = min_y;
+            for (const auto& landmark: landmarks.landmark())
+            {
+                min_x = std::min(min_x, landmark.x());
+                max_x = std::max(max_x, landmark.x());
+                min_y = std::min(min_y, landmark.y());
+                max_y = std::max(max_y, landmark.y());
+            }
+            box.cx = 0.5f * (min_x + max_x);
+            box.cy = 0.5f * (min_y + max_y);
+            box.width = max_x - min_x;
+            box.height = max_y - min_y;
+            return box;
+        }
+
+        struct Track
+        {
+            FaceBox box;
+            // Frame the track was last matched in, to match it at most once
+            int64_t matched_frame = -1;
+        };
+    } // namespace
+
+    /**
+     * @brief Assign stable ids to the faces of a multi-face stream
+     *
+     * Each face is matched greedily to the closest live track by bounding box
+     * centroid, scaled by the face size, provided its size changed little.
+     * Unmatched faces start a new track with a fresh id; ids are never reused.
+     * Work per frame is linear in the number of faces times `max_faces`.
+     *
+     * IDS is aligned with the input vector. In a BeginLoop/EndLoop graph it is
+     * iterated by a BeginLoopFaceIdVectorCalculator next to the landmarks, so
+     * both share loop timestamps, and passed as FACE_ID to the stateful
+     * calculators inside the loop.
+     *
+     * INPUTS:
+     *      0 - Landmarks of every face (std::vector<NormalizedLandmarkList>)
+     * OUTPUTS:
+     *      IDS - Face Ids, one per face (std::vector<int>)
+     *      TIMESTAMP - (Optional) The frame timestamp as a packet, to clone
+     *                  into the loop for FrameInterval (Timestamp)
+     *
+     * Example:
+     *
+     * node {
+     *   calculator: "FaceTrackerCalculator"
+     *   input_stream: "multi_face_landmarks"
+     *   output_stream: "IDS:multi_face_ids"
+     *   output_stream: "TIMESTAMP:frame_timestamp"
+     * }
+     *
+     * node {
+     *   calculator: "BeginLoopNormalizedLandmarkListVectorCalculator"
+     *   input_stream: "ITERABLE:multi_face_landmarks"
+     *   input_stream: "CLONE:frame_timestamp"
+     *   output_stream: "ITEM:face_landmarks"
+     *   output_stream: "CLONE:face_frame_timestamp"
+     *   output_stream: "BATCH_END:landmark_timestamp"
+     * }
+     *
+     * node {
+     *   calculator: "BeginLoopFaceIdVectorCalculator"
+     *   input_stream: "ITERABLE:multi_face_ids"
+     *   output_stream: "ITEM:face_id"
+     *   output_stream: "BATCH_END:face_id_timestamp"
+     * }
+     *
+     * node {
+     *   calculator: "FaceMovementCalculator"
+     *   input_stream: "face_landmarks"
+     *   input_stream: "FACE_ID:face_id"
+     *   input_stream: "TIMESTAMP:face_frame_timestamp"
+     *   output_stream: "face_movement"
+     * }
+     *
+     */
+    class FaceTrackerCalculator: public CalculatorBase
+    {
+    private:
+        FaceTrackerCalculatorOptions m_options;
+        std::unique_ptr<FaceStateMap<Track>> m_tracks;
+        int m_next_id = 0;
+        int64_t m_frame = 0;
+
+    public:
+        FaceTrackerCalculator() = default;
+        ~FaceTrackerCalculator() override = default;
+
+        static absl::Status GetContract(CalculatorContract* cc);
+
+        absl::Status Open(CalculatorContext* cc) override;
+        absl::Status Process(CalculatorContext* cc) override;
+        absl::Status Close(CalculatorContext* cc) override;
+    };
+
+    // Register the calculator to be used in the graph
+    REGISTER_CALCULATOR(FaceTrackerCalculator);
+
+    absl::Status FaceTrackerCalculator::GetContract(CalculatorContract* cc)
+    {
+        cc->Inputs().Index(0).Set<std::vector<NormalizedLandmarkList>>();
+        cc->Outputs().Tag(kIdsStreamTag).Set<std::vector<int>>();
+        if (cc->Outputs().HasTag(kTimestampStreamTag))
+        {
+            cc->Outputs().Tag(kTimestampStreamTag).Set<Timestamp>();
+        }
+        return absl::OkStatus();
+    }
+
+    absl::Status FaceTrackerCalculator::Open(CalculatorContext* cc)
+    {
+        m_options = cc->Options<FaceTrackerCalculatorOptions>();
+        m_tracks = absl::make_unique<FaceStateMap<Track>>(std::max(m_options.max_faces(), 1));
+        cc->SetOffset(TimestampDiff(0));
+        return absl::OkStatus();
+    }
+
+    absl::Status FaceTrackerCalculator::Process(CalculatorContext* cc)
+    {
+        CALCULATOR_TRACE_SCOPE("FaceTrackerCalculator", cc);
+        const auto& faces = cc->Inputs().Index(0).Get<std::vector<NormalizedLandmarkList>>();
+        const int64_t now_us = cc->InputTimestamp().Microseconds();
+        m_tracks->Expire(now_us, m_options.timeout_ms() * 1000);
+        ++m_frame;
+
+        auto ids = absl::make_unique<std::vector<int>>();
+        ids->reserve(faces.size());
+        for (const auto& face: faces)
+        {
+            const FaceBox box = BoxOf(face);
+            const float size = std::max(std::sqrt(box.width * box.height), 1e-6f);
+
+            int best_id = FaceStateMap<Track>::kNoFace;
+            float best_distance = m_options.max_distance();
+            m_tracks->ForEach([&](int id, Track& track) {
+                if (track.matched_frame == m_frame) { return; }
+                const float track_size = std::max(std::sqrt(track.box.width * track.box.height), 1e-6f);
+                if (std::fabs(size - track_size) > m_options.max_size_change() * track_size) { return; }
+
+                const float distance = std::hypot(box.cx - track.box.cx, box.cy - track.box.cy) / track_size;
+                if (distance <= best_distance)
+                {
+                    best_distance = distance;
+                    best_id = id;
+                }
+            });
+
+            const int id = best_id != FaceStateMap<Track>::kNoFace ? best_id: m_next_id++;
+            Track& track = m_tracks->Get(id, now_us);
+            track.box = box;
+            track.matched_frame = m_frame;
+            ids->push_back(id);
+        }
+
+        cc->Outputs().Tag(kIdsStreamTag).Add(ids.release(), cc->InputTimestamp());
+        if (cc->Outputs().HasTag(kTimestampStreamTag))
+        {
+            cc->Outputs().Tag(kTimestampStreamTag).AddPacket(
+                MakePacket<Timestamp>(cc->InputTimestamp()).At(cc->InputTimestamp())
+            );
+        }
+        return absl::OkStatus();
+    } // Process()
+
+    absl::Status FaceTrackerCalculator::Close(CalculatorContext* cc)
+    { return absl::OkStatus(); }
+
+    typedef BeginLoopCalculator<std::vector<int>> BeginLoopFaceIdVectorCalculator;
+    REGISTER_CALCULATOR(BeginLoopFaceIdVectorCalculator);
+
+} // namespace mediapipe
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstdint>
+
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "mediapipe/framework/calculator_framework.h"
+
+namespace mediapipe
+{
+
+    /**
+     * @brief Time base turning per-frame deltas into per-second rates
+     *
+     * With `normalize_by_time`, a delta is divided by the seconds elapsed since
+     * the previous frame of the same face, so the value does not depend on the
+     * frame rate; otherwise deltas are passed through per frame. An interval
+     * longer than `max_gap_ms` (rates only) restarts the face at zero instead
+     * of averaging the motion over the gap.
+     *
+     * Frame time is the input timestamp or, inside a BeginLoop/EndLoop
+     * subgraph where that is a loop index, the TIMESTAMP input. It needs a
+     * packet per frame holding the frame's Timestamp, such as the TIMESTAMP
+     * output of FaceTrackerCalculator, fed to a CLONE input of the BeginLoop
+     * calculator so that every item gets a copy; BATCH_END only arrives after
+     * the last item. A connected TIMESTAMP without a packet is an error.
+     *
+     * INPUTS:
+     *      TIMESTAMP - (Optional) Frame timestamp cloned per item (Timestamp)
+     *
+     * Example:
+     *
+     * node {
+     *   calculator: "BeginLoopNormalizedLandmarkListVectorCalculator"
+     *   input_stream: "ITERABLE:multi_face_landmarks"
+     *   input_stream: "CLONE:frame_timestamp"
+     *   output_stream: "ITEM:face_landmarks"
+     *   output_stream: "CLONE:face_frame_timestamp"
+     *   output_stream: "BATCH_END:landmark_timestamp"
+     * }
+     *
+     * node {
+     *   calculator: "FaceMovementCalculator"
+     *   input_stream: "face_landmarks"
+     *   input_stream: "TIMESTAMP:face_frame_timestamp"
+     *   output_stream: "face_movement"
+     * }
+     *
+     */
+    class FrameInterval
+    {
+    private:
+        bool m_normalize = false;
+        int64_t m_max_gap_us = 0;
+
+    public:
+        static constexpr char kTimestampTag[] = "TIMESTAMP";
+
+        static void SetContract(CalculatorContract* cc)
+        {
+            if (cc->Inputs().HasTag(kTimestampTag))
+            {
+                cc->Inputs().Tag(kTimestampTag).Set<Timestamp>();
+            }
+        }
+
+        void Open(bool normalize_by_time, double max_gap_ms)
+        {
+            m_normalize = normalize_by_time;
+            m_max_gap_us = static_cast<int64_t>(max_gap_ms * 1000.0);
+        }
+
+        // Frame time in microseconds
+        static absl::StatusOr<int64_t> Now(CalculatorContext* cc)
+        {
+            if (!cc->Inputs().HasTag(kTimestampTag)) { return cc->InputTimestamp().Value(); }
+            if (cc->Inputs().Tag(kTimestampTag).IsEmpty())
+            {
+                return absl::InvalidArgumentError(absl::StrCat(
+                    "TIMESTAMP is connected but empty at ", cc->InputTimestamp().DebugString()
+                ));
+            }
+            return cc->Inputs().Tag(kTimestampTag).Get<Timestamp>().Value();
+        }
+
+        // Factor applied to a delta since `previous_us`; 0 when the face starts
+        // over (first frame, time not increasing or a gap over max_gap_ms)
+        double Scale(bool is_first, int64_t previous_us, int64_t now_us) const
+        {
+            if (is_first) { return 0.0; }
+            if (!m_normalize) { return 1.0; }
+            const int64_t elapsed_us = now_us - previous_us;
+            if (elapsed_us <= 0 || (m_max_gap_us > 0 && elapsed_us > m_max_gap_us)) { return 0.0; }
+            return 1e6 / elapsed_us;
+        }
+    };
+
+} // namespace mediapipe
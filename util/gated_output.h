@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/port/status.h"
+#include "mediapipe/calculators/custom/util/face_id.h"
+#include "mediapipe/calculators/custom/util/face_state_map.h"
+#include "mediapipe/calculators/custom/util/frame_interval.h"
+
+namespace mediapipe
+{
+
+    /**
+     * @brief Re-emit a calculator's previous output while its GATE input is closed
+     *
+     * GATE is an optional bool input, usually from MotionGateCalculator, where
+     * false means the landmarks barely changed and the previous result can be
+     * reused. The cached packet is re-emitted at the new timestamp without
+     * copying its payload. With a FACE_ID input one packet is cached per face
+     * and dropped once the face is unseen for `timeout_ms` of frame time
+     * (TIMESTAMP input inside a loop, see FrameInterval).
+     *
+     * Update() must run at the start of every Process() before Reemit() and
+     * Remember().
+     */
+    class GatedOutput
+    {
+    private:
+        FaceStateMap<Packet> m_last_packets;
+        int64_t m_timeout_us;
+        int m_face_id = 0;
+        int64_t m_now_us = 0;
+
+    public:
+        static constexpr char kGateTag[] = "GATE";
+
+        explicit GatedOutput(int64_t timeout_ms = FaceId::kDefaultTimeoutMs)
+            : m_timeout_us(timeout_ms * 1000)
+        {}
+
+        static absl::Status SetContract(CalculatorContract* cc)
+        {
+            if (cc->Inputs().HasTag(kGateTag)) { cc->Inputs().Tag(kGateTag).Set<bool>(); }
+            FrameInterval::SetContract(cc);
+            return FaceId::SetContract(cc);
+        }
+
+        // Resolves the face and frame time of this packet and expires faces
+        // gone too long
+        absl::Status Update(CalculatorContext* cc)
+        {
+            const auto face_id = FaceId::Of(cc);
+            if (!face_id.ok()) { return face_id.status(); }
+            const auto now = FrameInterval::Now(cc);
+            if (!now.ok()) { return now.status(); }
+            m_face_id = *face_id;
+            m_now_us = *now;
+            m_last_packets.Expire(m_now_us, m_timeout_us);
+            return absl::OkStatus();
+        }
+
+        // Returns true after re-emitting the previous packet to `output`,
+        // in which case the caller should skip its computation
+        bool Reemit(CalculatorContext* cc, OutputStreamShard& output)
+        {
+            if (!cc->Inputs().HasTag(kGateTag) || cc->Inputs().Tag(kGateTag).IsEmpty()) { return false; }
+            if (cc->Inputs().Tag(kGateTag).Get<bool>()) { return false; }
+
+            const Packet* last_packet = m_last_packets.Find(m_face_id);
+            if (!last_packet || last_packet->IsEmpty()) { return false; }
+            output.AddPacket(last_packet->At(cc->InputTimestamp()));
+            return true;
+        }
+
+        void Remember(CalculatorContext* cc, const Packet& packet)
+        {
+            m_last_packets.Get(m_face_id, m_now_us) = packet;
+        }
+    };
+
+} // namespace mediapipe
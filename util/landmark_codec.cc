@@ -0,0 +1,279 @@
+#include "mediapipe/calculators/custom/util/landmark_codec.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace mediapipe
+{
+
+    namespace
+    {
+        constexpr uint8_t kVersion = 1;
+        constexpr uint8_t kKeyframe = 1;
+        constexpr size_t kHeaderSize = 1 + 1 + 2 + 4 + 4 + 3;
+
+        // Quotients from here on are sent as raw 32-bit values
+        constexpr uint32_t kEscapeQuotient = 24;
+        constexpr uint32_t kMaxRiceParameter = 24;
+
+        uint32_t ZigZag(int32_t value)
+        {
+            return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+        }
+
+        int32_t UnZigZag(uint32_t value)
+        {
+            return static_cast<int32_t>(value >> 1) ^ -static_cast<int32_t>(value & 1);
+        }
+
+        // Quantized values stay in this range, so residuals fit in 32 bits
+        constexpr int32_t kMinQuantized = std::numeric_limits<int32_t>::min() / 2;
+        constexpr int32_t kMaxQuantized = std::numeric_limits<int32_t>::max() / 2;
+
+        int32_t Quantize(float value, float step)
+        {
+            const double q = std::nearbyint(static_cast<double>(value) / step);
+            if (!(q > kMinQuantized)) { return kMinQuantized; }
+            if (!(q < kMaxQuantized)) { return kMaxQuantized; }
+            return static_cast<int32_t>(q);
+        }
+
+        // The wire format is little-endian whatever the host
+        void AppendLittleEndian(uint32_t value, int bytes, std::string* out)
+        {
+            for (int i = 0; i < bytes; ++i) { out->push_back(static_cast<char>((value >> (8 * i)) & 0xff)); }
+        }
+
+        uint32_t ReadLittleEndian(const char* data, int bytes)
+        {
+            uint32_t value = 0;
+            for (int i = 0; i < bytes; ++i) { value |= static_cast<uint32_t>(static_cast<uint8_t>(data[i])) << (8 * i); }
+            return value;
+        }
+
+        uint32_t FloatBits(float value)
+        {
+            uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        }
+
+        float BitsFloat(uint32_t bits)
+        {
+            float value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+
+        // Rice parameter close to the optimum for a geometric distribution with this mean
+        uint8_t RiceParameter(uint64_t sum, uint64_t count)
+        {
+            if (count == 0 || sum < count) { return 0; }
+            uint8_t k = 0;
+            uint64_t mean = sum / count;
+            while (mean > 1 && k < kMaxRiceParameter) { mean >>= 1; ++k; }
+            return k;
+        }
+
+        class BitWriter
+        {
+        private:
+            std::string* m_out;
+            uint64_t m_bits = 0;
+            int m_count = 0;
+
+        public:
+            explicit BitWriter(std::string* out): m_out(out) {}
+
+            void Put(uint32_t value, int width)
+            {
+                if (width == 0) { return; }
+                m_bits |= static_cast<uint64_t>(value & ((uint64_t(1) << width) - 1)) << m_count;
+                m_count += width;
+                while (m_count >= 8)
+                {
+                    m_out->push_back(static_cast<char>(m_bits & 0xff));
+                    m_bits >>= 8;
+                    m_count -= 8;
+                }
+            }
+
+            void PutRice(uint32_t value, uint8_t k)
+            {
+                const uint32_t quotient = value >> k;
+                if (quotient >= kEscapeQuotient)
+                {
+                    this->Put((1u << kEscapeQuotient) - 1, kEscapeQuotient);
+                    this->Put(value, 32);
+                    return;
+                }
+                // Unary quotient, ones terminated by a zero
+                this->Put((1u << quotient) - 1, quotient + 1);
+                this->Put(value, k);
+            }
+
+            void Flush()
+            {
+                if (m_count > 0) { m_out->push_back(static_cast<char>(m_bits & 0xff)); }
+                m_bits = 0;
+                m_count = 0;
+            }
+        };
+
+        class BitReader
+        {
+        private:
+            const uint8_t* m_data;
+            size_t m_size;
+            size_t m_offset = 0;
+            uint64_t m_bits = 0;
+            int m_count = 0;
+
+            bool Fill(int width)
+            {
+                while (m_count < width)
+                {
+                    if (m_offset >= m_size) { return false; }
+                    m_bits |= static_cast<uint64_t>(m_data[m_offset++]) << m_count;
+                    m_count += 8;
+                }
+                return true;
+            }
+
+        public:
+            BitReader(const uint8_t* data, size_t size): m_data(data), m_size(size) {}
+
+            bool Get(int width, uint32_t* value)
+            {
+                if (width == 0) { *value = 0; return true; }
+                if (!this->Fill(width)) { return false; }
+                *value = static_cast<uint32_t>(m_bits & ((uint64_t(1) << width) - 1));
+                m_bits >>= width;
+                m_count -= width;
+                return true;
+            }
+
+            bool GetRice(uint8_t k, uint32_t* value)
+            {
+                uint32_t quotient = 0, bit;
+                while (quotient < kEscapeQuotient)
+                {
+                    if (!this->Get(1, &bit)) { return false; }
+                    if (!bit) { break; }
+                    ++quotient;
+                }
+                if (quotient == kEscapeQuotient) { return this->Get(32, value); }
+                uint32_t remainder;
+                if (!this->Get(k, &remainder)) { return false; }
+                *value = (quotient << k) | remainder;
+                return true;
+            }
+        };
+    } // namespace
+
+    LandmarkEncoder::LandmarkEncoder(float step, uint32_t keyframe_interval)
+        : m_step(step), m_keyframe_interval(std::max<uint32_t>(keyframe_interval, 1))
+    {}
+
+    void LandmarkEncoder::Encode(const float* xyz, int num_landmarks, std::string* out)
+    {
+        num_landmarks = std::min(num_landmarks, int(std::numeric_limits<uint16_t>::max()));
+        const size_t num_values = static_cast<size_t>(num_landmarks) * 3;
+        const bool is_keyframe = m_prev.size() != num_values || m_sequence % m_keyframe_interval == 0;
+
+        // Residuals against the prediction, the quantized values become the next reference
+        m_prev.resize(num_values);
+        m_residuals.resize(num_values);
+        uint64_t sums[3] = {0, 0, 0};
+        int32_t spatial[3] = {0, 0, 0};
+        for (size_t i = 0; i < num_values; ++i)
+        {
+            const size_t axis = i % 3;
+            const int32_t q = Quantize(xyz[i], m_step);
+            const int32_t prediction = is_keyframe ? spatial[axis]: m_prev[i];
+            spatial[axis] = q;
+            m_prev[i] = q;
+            m_residuals[i] = ZigZag(q - prediction);
+            sums[axis] += m_residuals[i];
+        }
+        const uint8_t k[3] = {
+            RiceParameter(sums[0], num_landmarks),
+            RiceParameter(sums[1], num_landmarks),
+            RiceParameter(sums[2], num_landmarks),
+        };
+
+        out->clear();
+        out->reserve(kHeaderSize + num_values);
+        const uint8_t flags = is_keyframe ? kKeyframe: 0;
+        out->push_back(static_cast<char>(kVersion));
+        out->push_back(static_cast<char>(flags));
+        AppendLittleEndian(num_landmarks, 2, out);
+        AppendLittleEndian(m_sequence, 4, out);
+        AppendLittleEndian(FloatBits(m_step), 4, out);
+        out->append(reinterpret_cast<const char*>(k), sizeof(k));
+
+        BitWriter writer(out);
+        for (size_t i = 0; i < num_values; ++i) { writer.PutRice(m_residuals[i], k[i % 3]); }
+        writer.Flush();
+        ++m_sequence;
+    } // Encode()
+
+    LandmarkDecoder::Result LandmarkDecoder::Decode(const std::string& frame, std::vector<float>* xyz)
+    {
+        if (frame.size() < kHeaderSize || static_cast<uint8_t>(frame[0]) != kVersion) { return kCorrupt; }
+
+        const uint8_t flags = frame[1];
+        const uint16_t count = ReadLittleEndian(frame.data() + 2, 2);
+        const uint32_t sequence = ReadLittleEndian(frame.data() + 4, 4);
+        const float step = BitsFloat(ReadLittleEndian(frame.data() + 8, 4));
+        uint8_t k[3];
+        std::memcpy(k, frame.data() + 12, sizeof(k));
+        if (!(step > 0.0f) || k[0] > kMaxRiceParameter || k[1] > kMaxRiceParameter || k[2] > kMaxRiceParameter)
+        {
+            return kCorrupt;
+        }
+
+        const size_t num_values = static_cast<size_t>(count) * 3;
+        const bool is_keyframe = flags & kKeyframe;
+        // A delta frame is only usable right after the frame it was coded against
+        if (!is_keyframe && (m_prev.size() != num_values || step != m_step || sequence != m_sequence + 1))
+        {
+            m_prev.clear();
+            return kMissingReference;
+        }
+
+        std::vector<int32_t> values(num_values);
+        BitReader reader(reinterpret_cast<const uint8_t*>(frame.data()) + kHeaderSize, frame.size() - kHeaderSize);
+        int32_t spatial[3] = {0, 0, 0};
+        for (size_t i = 0; i < num_values; ++i)
+        {
+            const size_t axis = i % 3;
+            uint32_t residual;
+            if (!reader.GetRice(k[axis], &residual))
+            {
+                m_prev.clear();
+                return kCorrupt;
+            }
+            const int32_t prediction = is_keyframe ? spatial[axis]: m_prev[i];
+            // An encoder never leaves the quantized range, a corrupt residual can
+            const int64_t value = static_cast<int64_t>(prediction) + UnZigZag(residual);
+            if (value < kMinQuantized || value > kMaxQuantized)
+            {
+                m_prev.clear();
+                return kCorrupt;
+            }
+            values[i] = static_cast<int32_t>(value);
+            spatial[axis] = values[i];
+        }
+
+        m_prev.swap(values);
+        m_step = step;
+        m_sequence = sequence;
+        xyz->resize(num_values);
+        for (size_t i = 0; i < num_values; ++i) { (*xyz)[i] = static_cast<float>(m_prev[i] * static_cast<double>(step)); }
+        return kDecoded;
+    } // Decode()
+
+} // namespace mediapipe
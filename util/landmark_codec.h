@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace mediapipe
+{
+
+    /**
+     * @brief Compact encoding of a stream of landmark xyz triplets
+     *
+     * Each coordinate is quantized to a multiple of `step`, so the decoded
+     * value is within step / 2 of the input, up to float rounding. Keyframes code every
+     * landmark against the previous landmark of the same frame; the frames in
+     * between code it against the same landmark of the previous frame. The
+     * prediction uses the quantized values both sides hold, so the error never
+     * accumulates. Residuals are zigzag mapped and Rice coded with one
+     * parameter per axis, chosen per frame and stored in its header.
+     *
+     * Frame layout (little-endian):
+     *      uint8   version
+     *      uint8   flags, kKeyframe
+     *      uint16  number of landmarks
+     *      uint32  sequence number
+     *      float   step
+     *      uint8   Rice parameter for x, y and z
+     *      ...     bit stream, landmark-major, x y z residuals
+     */
+    class LandmarkEncoder
+    {
+    private:
+        float m_step;
+        uint32_t m_keyframe_interval;
+        uint32_t m_sequence = 0;
+        std::vector<int32_t> m_prev;
+        std::vector<uint32_t> m_residuals;
+
+    public:
+        // A keyframe_interval of 0 or 1 makes every frame a keyframe
+        LandmarkEncoder(float step, uint32_t keyframe_interval);
+
+        // Forces the next frame to be a keyframe, for example for a new receiver
+        void RequestKeyframe() { m_prev.clear(); }
+
+        // Encodes `num_landmarks` packed xyz triplets, replacing `out`
+        void Encode(const float* xyz, int num_landmarks, std::string* out);
+    };
+
+    class LandmarkDecoder
+    {
+    private:
+        float m_step = 0.0f;
+        uint32_t m_sequence = 0;
+        std::vector<int32_t> m_prev;
+
+    public:
+        enum Result
+        {
+            kDecoded,
+            // A delta frame without its reference, wait for the next keyframe
+            kMissingReference,
+            kCorrupt,
+        };
+
+        // Decodes one frame into packed xyz triplets
+        Result Decode(const std::string& frame, std::vector<float>* xyz);
+    };
+
+} // namespace mediapipe
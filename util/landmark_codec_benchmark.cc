@@ -0,0 +1,81 @@
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "mediapipe/calculators/custom/util/landmark_codec.h"
+
+namespace mediapipe
+{
+
+    namespace
+    {
+        constexpr int kNumLandmarks = 478;
+        constexpr int kNumFrames = 64;
+        constexpr double kFramesPerSecond = 30.0;
+
+        // Face mesh frames with small per-frame motion and landmark jitter
+        std::vector<std::vector<float>> MakeFrames()
+        {
+            std::vector<std::vector<float>> frames(kNumFrames, std::vector<float>(3 * kNumLandmarks));
+            uint32_t noise = 12345;
+            for (int f = 0; f < kNumFrames; ++f)
+            {
+                for (int i = 0; i < kNumLandmarks; ++i)
+                {
+                    noise = noise * 1664525u + 1013904223u;
+                    const float jitter = ((noise >> 8) % 1000) * 2e-7f;
+                    frames[f][3 * i + 0] = 0.5f + 0.2f * std::sin(i * 0.37f) + 0.002f * std::sin(f * 0.1f) + jitter;
+                    frames[f][3 * i + 1] = 0.5f + 0.2f * std::cos(i * 0.53f) + 0.001f * std::cos(f * 0.1f) + jitter;
+                    frames[f][3 * i + 2] = 0.05f * std::sin(i * 0.11f) + jitter;
+                }
+            }
+            return frames;
+        }
+
+        // Args: quantization step in 1e-6 units, keyframe interval
+        void BM_LandmarkEncode(benchmark::State& state)
+        {
+            const auto frames = MakeFrames();
+            LandmarkEncoder encoder(state.range(0) * 1e-6f, state.range(1));
+            std::string out;
+            size_t bytes = 0;
+            int64_t count = 0;
+            for (auto _: state)
+            {
+                encoder.Encode(frames[count % kNumFrames].data(), kNumLandmarks, &out);
+                bytes += out.size();
+                ++count;
+                benchmark::DoNotOptimize(out.data());
+            }
+            state.SetItemsProcessed(count);
+            state.counters["bytes_per_frame"] = static_cast<double>(bytes) / count;
+            state.counters["kbit_per_s_at_30fps"] = 8.0 * bytes / count * kFramesPerSecond / 1000.0;
+            state.counters["raw_ratio"] = 3.0 * kNumLandmarks * sizeof(float) * count / bytes;
+        }
+
+        void BM_LandmarkDecode(benchmark::State& state)
+        {
+            const auto frames = MakeFrames();
+            LandmarkEncoder encoder(state.range(0) * 1e-6f, state.range(1));
+            std::vector<std::string> encoded(kNumFrames);
+            for (int f = 0; f < kNumFrames; ++f) { encoder.Encode(frames[f].data(), kNumLandmarks, &encoded[f]); }
+
+            LandmarkDecoder decoder;
+            std::vector<float> xyz;
+            int64_t count = 0;
+            for (auto _: state)
+            {
+                // Wrapping around breaks the delta chain, restart from a keyframe
+                if (count % kNumFrames == 0) { decoder = LandmarkDecoder(); }
+                benchmark::DoNotOptimize(decoder.Decode(encoded[count % kNumFrames], &xyz));
+                ++count;
+            }
+            state.SetItemsProcessed(count);
+        }
+    } // namespace
+
+    BENCHMARK(BM_LandmarkEncode)->Args({100, 30})->Args({100, 1})->Args({10, 30});
+    BENCHMARK(BM_LandmarkDecode)->Args({100, 30})->Args({100, 1})->Args({10, 30});
+
+} // namespace mediapipe
@@ -0,0 +1,142 @@
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/calculators/custom/util/landmark_codec.h"
+
+namespace mediapipe
+{
+
+    namespace
+    {
+        constexpr int kNumLandmarks = 478;
+        constexpr float kStep = 1e-4f;
+
+        // A face mesh drifting slowly, like consecutive camera frames
+        std::vector<float> MeshAt(int frame)
+        {
+            std::vector<float> xyz(3 * kNumLandmarks);
+            for (int i = 0; i < kNumLandmarks; ++i)
+            {
+                xyz[3 * i + 0] = 0.5f + 0.2f * std::sin(i * 0.37f) + 0.001f * frame;
+                xyz[3 * i + 1] = 0.5f + 0.2f * std::cos(i * 0.53f) - 0.0005f * frame;
+                xyz[3 * i + 2] = 0.05f * std::sin(i * 0.11f + 0.01f * frame);
+            }
+            return xyz;
+        }
+
+        void ExpectWithinHalfStep(const std::vector<float>& expected, const std::vector<float>& actual, float step)
+        {
+            ASSERT_EQ(expected.size(), actual.size());
+            for (size_t i = 0; i < expected.size(); ++i)
+            {
+                // Half a step, plus float rounding of the values
+                EXPECT_LE(std::fabs(expected[i] - actual[i]), step / 2 + 1e-6f) << "value " << i;
+            }
+        }
+    } // namespace
+
+    TEST(LandmarkCodecTest, RoundTripStaysWithinHalfStepAcrossKeyframes)
+    {
+        LandmarkEncoder encoder(kStep, 5);
+        LandmarkDecoder decoder;
+        std::string frame;
+        std::vector<float> decoded;
+        for (int f = 0; f < 23; ++f)
+        {
+            const auto xyz = MeshAt(f);
+            encoder.Encode(xyz.data(), kNumLandmarks, &frame);
+            EXPECT_EQ(frame[1] != 0, f % 5 == 0) << "frame " << f;
+            ASSERT_EQ(decoder.Decode(frame, &decoded), LandmarkDecoder::kDecoded);
+            ExpectWithinHalfStep(xyz, decoded, kStep);
+        }
+    }
+
+    TEST(LandmarkCodecTest, LargeJumpsUseEscapes)
+    {
+        LandmarkEncoder encoder(kStep, 100);
+        LandmarkDecoder decoder;
+        std::string frame;
+        std::vector<float> decoded;
+
+        auto xyz = MeshAt(0);
+        encoder.Encode(xyz.data(), kNumLandmarks, &frame);
+        ASSERT_EQ(decoder.Decode(frame, &decoded), LandmarkDecoder::kDecoded);
+
+        // Mostly still, a few landmarks jump far beyond the Rice range
+        xyz[0] += 150.0f;
+        xyz[4] -= 90.0f;
+        xyz[3 * kNumLandmarks - 1] = -1.0e4f;
+        encoder.Encode(xyz.data(), kNumLandmarks, &frame);
+        EXPECT_EQ(frame[1], 0);
+        ASSERT_EQ(decoder.Decode(frame, &decoded), LandmarkDecoder::kDecoded);
+        ExpectWithinHalfStep(xyz, decoded, kStep);
+    }
+
+    TEST(LandmarkCodecTest, DeltaFrameWithoutReferenceWaitsForKeyframe)
+    {
+        LandmarkEncoder encoder(kStep, 3);
+        LandmarkDecoder decoder;
+        std::string frame;
+        std::vector<float> decoded;
+
+        for (int f = 0; f < 2; ++f)
+        {
+            const auto xyz = MeshAt(f);
+            encoder.Encode(xyz.data(), kNumLandmarks, &frame);
+        }
+        // Frame 0 was lost, frame 1 is a delta
+        EXPECT_EQ(decoder.Decode(frame, &decoded), LandmarkDecoder::kMissingReference);
+
+        encoder.RequestKeyframe();
+        const auto xyz = MeshAt(2);
+        encoder.Encode(xyz.data(), kNumLandmarks, &frame);
+        ASSERT_EQ(decoder.Decode(frame, &decoded), LandmarkDecoder::kDecoded);
+        ExpectWithinHalfStep(xyz, decoded, kStep);
+    }
+
+    TEST(LandmarkCodecTest, HeaderIsLittleEndian)
+    {
+        LandmarkEncoder encoder(0.5f, 1);
+        std::string frame;
+        const float xyz[3] = { 1.0f, 2.0f, 3.0f };
+        encoder.Encode(xyz, 1, &frame);
+        encoder.Encode(xyz, 1, &frame);
+
+        ASSERT_GE(frame.size(), 15u);
+        // One landmark, sequence 1, step 0.5f = 0x3f000000
+        EXPECT_EQ(std::string(frame.data() + 2, 2), std::string("\x01\x00", 2));
+        EXPECT_EQ(std::string(frame.data() + 4, 4), std::string("\x01\x00\x00\x00", 4));
+        EXPECT_EQ(std::string(frame.data() + 8, 4), std::string("\x00\x00\x00\x3f", 4));
+    }
+
+    TEST(LandmarkCodecTest, OutOfRangeResidualsAreCorrupt)
+    {
+        // Keyframe of two landmarks, Rice parameter 0, every residual escaped
+        // to the largest positive value, so x would overflow 32 bits
+        std::string frame("\x01\x01\x02\x00\x00\x00\x00\x00\x00\x00\x80\x3f\x00\x00\x00", 15);
+        for (int v = 0; v < 6; ++v)
+        {
+            frame.append("\xff\xff\xff", 3);
+            frame.append("\xfe\xff\xff\xff", 4);
+        }
+        LandmarkDecoder decoder;
+        std::vector<float> decoded;
+        EXPECT_EQ(decoder.Decode(frame, &decoded), LandmarkDecoder::kCorrupt);
+    }
+
+    TEST(LandmarkCodecTest, TruncatedFramesAreCorrupt)
+    {
+        LandmarkEncoder encoder(kStep, 1);
+        std::string frame;
+        const auto xyz = MeshAt(0);
+        encoder.Encode(xyz.data(), kNumLandmarks, &frame);
+
+        LandmarkDecoder decoder;
+        std::vector<float> decoded;
+        EXPECT_EQ(decoder.Decode(frame.substr(0, frame.size() / 2), &decoded), LandmarkDecoder::kCorrupt);
+        EXPECT_EQ(decoder.Decode(frame.substr(0, 5), &decoded), LandmarkDecoder::kCorrupt);
+    }
+
+} // namespace mediapipe
@@ -0,0 +1,101 @@
+#include <string>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/port/status.h"
+#include "mediapipe/framework/port/logging.h"
+#include "mediapipe/framework/formats/landmark.pb.h"
+#include "mediapipe/calculators/custom/util/landmark_codec.h"
+#include "mediapipe/calculators/custom/util/calculator_trace.h"
+
+namespace mediapipe
+{
+
+    /**
+     * @brief Decode landmarks encoded by LandmarkEncoderCalculator
+     *
+     * Frames that cannot be decoded, because a frame before them was lost or
+     * they are damaged, produce no output; decoding resumes at the next
+     * keyframe. The output feeds LandmarkStandardizationCalculator and the
+     * other landmark calculators like the original stream.
+     *
+     * INPUTS:
+     *      0 - Encoded Frame (std::string)
+     * OUTPUTS:
+     *      0 - Landmarks (NormalizedLandmarkList)
+     *
+     * Example:
+     *
+     * node {
+     *   calculator: "LandmarkDecoderCalculator"
+     *   input_stream: "face_landmarks_encoded"
+     *   output_stream: "face_landmarks"
+     * }
+     *
+     */
+    class LandmarkDecoderCalculator: public CalculatorBase
+    {
+    private:
+        LandmarkDecoder m_decoder;
+        std::vector<float> m_xyz;
+
+    public:
+        LandmarkDecoderCalculator() = default;
+        ~LandmarkDecoderCalculator() override = default;
+
+        static absl::Status GetContract(CalculatorContract* cc);
+
+        absl::Status Open(CalculatorContext* cc) override;
+        absl::Status Process(CalculatorContext* cc) override;
+        absl::Status Close(CalculatorContext* cc) override;
+    };
+
+    // Register the calculator to be used in the graph
+    REGISTER_CALCULATOR(LandmarkDecoderCalculator);
+
+    absl::Status LandmarkDecoderCalculator::GetContract(CalculatorContract* cc)
+    {
+        cc->Inputs().Index(0).Set<std::string>();
+        cc->Outputs().Index(0).Set<NormalizedLandmarkList>();
+        return absl::OkStatus();
+    }
+
+    absl::Status LandmarkDecoderCalculator::Open(CalculatorContext* cc)
+    {
+        cc->SetOffset(TimestampDiff(0));
+        return absl::OkStatus();
+    }
+
+    absl::Status LandmarkDecoderCalculator::Process(CalculatorContext* cc)
+    {
+        CALCULATOR_TRACE_SCOPE("LandmarkDecoderCalculator", cc);
+        const auto& frame = cc->Inputs().Index(0).Get<std::string>();
+
+        const auto result = m_decoder.Decode(frame, &m_xyz);
+        if (result != LandmarkDecoder::kDecoded)
+        {
+            LOG_IF(WARNING, result == LandmarkDecoder::kCorrupt)
+                << "Dropping corrupt landmark frame at " << cc->InputTimestamp();
+            return absl::OkStatus();
+        }
+
+        const int num_landmarks = m_xyz.size() / 3;
+        auto landmarks = absl::make_unique<NormalizedLandmarkList>();
+        landmarks->mutable_landmark()->Reserve(num_landmarks);
+        for (int i = 0; i < num_landmarks; ++i)
+        {
+            NormalizedLandmark* landmark = landmarks->add_landmark();
+            landmark->set_x(m_xyz[3 * i + 0]);
+            landmark->set_y(m_xyz[3 * i + 1]);
+            landmark->set_z(m_xyz[3 * i + 2]);
+        }
+        cc->Outputs().Index(0).Add(landmarks.release(), cc->InputTimestamp());
+
+        return absl::OkStatus();
+    } // Process()
+
+    absl::Status LandmarkDecoderCalculator::Close(CalculatorContext* cc)
+    { return absl::OkStatus(); }
+
+} // namespace mediapipe
@@ -0,0 +1,109 @@
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/port/status.h"
+#include "mediapipe/framework/formats/landmark.pb.h"
+#include "mediapipe/calculators/custom/util/landmark_codec.h"
+#include "mediapipe/calculators/custom/util/landmark_encoder_calculator.pb.h"
+#include "mediapipe/calculators/custom/util/calculator_trace.h"
+
+namespace mediapipe
+{
+
+    /**
+     * @brief Encode landmarks into a compact byte stream
+     *
+     * Quantizes, predicts from the previous frame and Rice codes the residuals,
+     * see LandmarkEncoder. Frames must be decoded in order by
+     * LandmarkDecoderCalculator; keyframes every `keyframe_interval` frames let
+     * a receiver recover from lost frames.
+     *
+     * INPUTS:
+     *      0 - Landmarks (NormalizedLandmarkList)
+     * OUTPUTS:
+     *      0 - Encoded Frame (std::string)
+     *
+     * Example:
+     *
+     * node {
+     *   calculator: "LandmarkEncoderCalculator"
+     *   input_stream: "face_landmarks"
+     *   output_stream: "face_landmarks_encoded"
+     *   node_options: {
+     *     [type.googleapis.com/mediapipe.LandmarkEncoderCalculatorOptions] {
+     *       step: 0.0005
+     *       keyframe_interval: 30
+     *     }
+     *   }
+     * }
+     *
+     */
+    class LandmarkEncoderCalculator: public CalculatorBase
+    {
+    private:
+        std::unique_ptr<LandmarkEncoder> m_encoder;
+        std::vector<float> m_xyz;
+
+    public:
+        LandmarkEncoderCalculator() = default;
+        ~LandmarkEncoderCalculator() override = default;
+
+        static absl::Status GetContract(CalculatorContract* cc);
+
+        absl::Status Open(CalculatorContext* cc) override;
+        absl::Status Process(CalculatorContext* cc) override;
+        absl::Status Close(CalculatorContext* cc) override;
+    };
+
+    // Register the calculator to be used in the graph
+    REGISTER_CALCULATOR(LandmarkEncoderCalculator);
+
+    absl::Status LandmarkEncoderCalculator::GetContract(CalculatorContract* cc)
+    {
+        cc->Inputs().Index(0).Set<NormalizedLandmarkList>();
+        cc->Outputs().Index(0).Set<std::string>();
+        return absl::OkStatus();
+    }
+
+    absl::Status LandmarkEncoderCalculator::Open(CalculatorContext* cc)
+    {
+        const auto& options = cc->Options<LandmarkEncoderCalculatorOptions>();
+        if (!(options.step() > 0.0f))
+        {
+            return absl::InvalidArgumentError("LandmarkEncoderCalculator needs a positive step");
+        }
+        m_encoder = absl::make_unique<LandmarkEncoder>(options.step(), std::max(options.keyframe_interval(), 1));
+        cc->SetOffset(TimestampDiff(0));
+        return absl::OkStatus();
+    }
+
+    absl::Status LandmarkEncoderCalculator::Process(CalculatorContext* cc)
+    {
+        CALCULATOR_TRACE_SCOPE("LandmarkEncoderCalculator", cc);
+        const auto& landmarks = cc->Inputs().Index(0).Get<NormalizedLandmarkList>();
+        const int num_landmarks = landmarks.landmark_size();
+
+        m_xyz.resize(num_landmarks * 3);
+        for (int i = 0; i < num_landmarks; ++i)
+        {
+            const auto& landmark = landmarks.landmark(i);
+            m_xyz[3 * i + 0] = landmark.x();
+            m_xyz[3 * i + 1] = landmark.y();
+            m_xyz[3 * i + 2] = landmark.z();
+        }
+
+        auto frame = absl::make_unique<std::string>();
+        m_encoder->Encode(m_xyz.data(), num_landmarks, frame.get());
+        cc->Outputs().Index(0).Add(frame.release(), cc->InputTimestamp());
+
+        return absl::OkStatus();
+    } // Process()
+
+    absl::Status LandmarkEncoderCalculator::Close(CalculatorContext* cc)
+    { return absl::OkStatus(); }
+
+} // namespace mediapipe
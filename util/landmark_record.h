@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+
+namespace mediapipe
+{
+
+    /**
+     * @brief Wire format of one landmark frame sent to LandmarkSocketSourceCalculator
+     *
+     * One record per datagram: this header followed by `num_landmarks` packed
+     * xyz float triplets, all host-endian. A record with
+     * kLandmarkRecordEndOfStream set may carry no landmarks.
+     */
+    struct LandmarkRecordHeader
+    {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t flags;
+        uint32_t client_id;
+        uint32_t num_landmarks;
+        // Sender clock, must increase; each client gets its own source node
+        int64_t timestamp_us;
+    };
+
+    constexpr uint32_t kLandmarkRecordMagic = 0x4c4d4b31;  // "LMK1"
+    constexpr uint16_t kLandmarkRecordVersion = 1;
+    constexpr uint16_t kLandmarkRecordEndOfStream = 1;
+
+    static_assert(sizeof(LandmarkRecordHeader) == 24, "LandmarkRecordHeader must stay packed");
+
+} // namespace mediapipe
@@ -0,0 +1,243 @@
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/port/status.h"
+#include "mediapipe/framework/port/logging.h"
+#include "mediapipe/framework/formats/landmark.pb.h"
+#include "mediapipe/framework/tool/status_util.h"
+#include "mediapipe/calculators/custom/util/landmark_record.h"
+#include "mediapipe/calculators/custom/util/landmark_socket_source_calculator.pb.h"
+#include "mediapipe/calculators/custom/util/calculator_trace.h"
+
+namespace mediapipe
+{
+
+    namespace
+    {
+        constexpr char kLandmarksStreamTag[] = "LANDMARKS";
+        constexpr char kClientIdStreamTag[]  = "CLIENT_ID";
+    } // namespace
+
+    /**
+     * @brief Receive landmark frames from local clients over a Unix datagram socket
+     *
+     * Binds a SOCK_DGRAM socket at `socket_path` and reads batches of
+     * LandmarkRecordHeader records with recvmmsg into preallocated buffers,
+     * parsing them in place. Only records of `client_id` are accepted, since
+     * timestamps from different senders' clocks cannot share one stream; run
+     * one node per client, each with its own socket_path. Each record becomes
+     * a packet at the sender's timestamp; records not newer than the last
+     * emitted one are dropped.
+     *
+     * Unix datagram sockets do not drop on overflow: when the graph falls
+     * behind, the receive queue fills and senders block (or get EAGAIN), which
+     * is the backpressure path.
+     *
+     * OUTPUTS:
+     *      LANDMARKS - Landmarks (NormalizedLandmarkList)
+     *      CLIENT_ID - (Optional) Sender Client Id (int)
+     *
+     * Example:
+     *
+     * node {
+     *   calculator: "LandmarkSocketSourceCalculator"
+     *   output_stream: "LANDMARKS:face_landmarks"
+     *   node_options: {
+     *     [type.googleapis.com/mediapipe.LandmarkSocketSourceCalculatorOptions] {
+     *       socket_path: "/run/proctor/landmarks.sock"
+     *       client_id: 1
+     *     }
+     *   }
+     * }
+     *
+     */
+    class LandmarkSocketSourceCalculator: public CalculatorBase
+    {
+    private:
+        LandmarkSocketSourceCalculatorOptions m_options;
+        int m_fd = -1;
+        size_t m_record_size = 0;
+
+        std::vector<char> m_buffer;
+        std::vector<struct iovec> m_iovecs;
+        std::vector<struct mmsghdr> m_messages;
+
+        Timestamp m_last_timestamp = Timestamp::Unstarted();
+        bool m_stop = false;
+
+        void Emit(CalculatorContext* cc, const char* data, size_t size);
+
+    public:
+        LandmarkSocketSourceCalculator() = default;
+        ~LandmarkSocketSourceCalculator() override = default;
+
+        static absl::Status GetContract(CalculatorContract* cc);
+
+        absl::Status Open(CalculatorContext* cc) override;
+        absl::Status Process(CalculatorContext* cc) override;
+        absl::Status Close(CalculatorContext* cc) override;
+    };
+
+    // Register the calculator to be used in the graph
+    REGISTER_CALCULATOR(LandmarkSocketSourceCalculator);
+
+    absl::Status LandmarkSocketSourceCalculator::GetContract(CalculatorContract* cc)
+    {
+        cc->Outputs().Tag(kLandmarksStreamTag).Set<NormalizedLandmarkList>();
+        if (cc->Outputs().HasTag(kClientIdStreamTag))
+        {
+            cc->Outputs().Tag(kClientIdStreamTag).Set<int>();
+        }
+        return absl::OkStatus();
+    }
+
+    absl::Status LandmarkSocketSourceCalculator::Open(CalculatorContext* cc)
+    {
+        m_options = cc->Options<LandmarkSocketSourceCalculatorOptions>();
+        struct sockaddr_un address {};
+        if (m_options.socket_path().empty() || m_options.socket_path().size() >= sizeof(address.sun_path))
+        {
+            return absl::InvalidArgumentError("LandmarkSocketSourceCalculator needs a valid socket_path");
+        }
+        if (m_options.batch_size() <= 0 || m_options.max_landmarks() < 0)
+        {
+            return absl::InvalidArgumentError("LandmarkSocketSourceCalculator needs a positive batch_size");
+        }
+        if (m_options.client_id() < 0 || m_options.client_id() > std::numeric_limits<uint32_t>::max())
+        {
+            return absl::InvalidArgumentError("LandmarkSocketSourceCalculator needs the client_id to accept");
+        }
+
+        m_fd = socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+        if (m_fd < 0)
+        {
+            return absl::UnavailableError(absl::StrCat("socket failed: ", std::strerror(errno)));
+        }
+        if (m_options.receive_buffer_bytes() > 0)
+        {
+            const int size = m_options.receive_buffer_bytes();
+            setsockopt(m_fd, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+        }
+
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, m_options.socket_path().c_str(), sizeof(address.sun_path) - 1);
+        unlink(address.sun_path);
+        if (bind(m_fd, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) != 0)
+        {
+            const int error = errno;
+            close(m_fd);
+            m_fd = -1;
+            return absl::UnavailableError(absl::StrCat(
+                "Failed to bind ", m_options.socket_path(), ": ", std::strerror(error)
+            ));
+        }
+
+        // One buffer per datagram, one byte larger to detect oversized records
+        m_record_size = sizeof(LandmarkRecordHeader) + size_t(m_options.max_landmarks()) * 3 * sizeof(float) + 1;
+        const size_t batch_size = m_options.batch_size();
+        m_buffer.resize(batch_size * m_record_size);
+        m_iovecs.resize(batch_size);
+        m_messages.resize(batch_size);
+        for (size_t i = 0; i < batch_size; ++i)
+        {
+            m_iovecs[i].iov_base = m_buffer.data() + i * m_record_size;
+            m_iovecs[i].iov_len = m_record_size;
+            m_messages[i] = {};
+            m_messages[i].msg_hdr.msg_iov = &m_iovecs[i];
+            m_messages[i].msg_hdr.msg_iovlen = 1;
+        }
+        return absl::OkStatus();
+    }
+
+    void LandmarkSocketSourceCalculator::Emit(CalculatorContext* cc, const char* data, size_t size)
+    {
+        LandmarkRecordHeader header;
+        if (size < sizeof(header) || size == m_record_size) { return; }
+        std::memcpy(&header, data, sizeof(header));
+        if (header.magic != kLandmarkRecordMagic || header.version != kLandmarkRecordVersion) { return; }
+        if (header.client_id != m_options.client_id()) { return; }
+
+        if (header.flags & kLandmarkRecordEndOfStream)
+        {
+            m_stop = m_options.stop_on_end_of_stream();
+            return;
+        }
+
+        const size_t payload = size_t(header.num_landmarks) * 3 * sizeof(float);
+        const Timestamp timestamp(header.timestamp_us);
+        if (size - sizeof(header) != payload || !timestamp.IsRangeValue() || timestamp <= m_last_timestamp)
+        {
+            VLOG(1) << "Dropping landmark record from client " << header.client_id << " at " << timestamp;
+            return;
+        }
+        m_last_timestamp = timestamp;
+
+        const char* xyz = data + sizeof(header);
+        auto landmarks = absl::make_unique<NormalizedLandmarkList>();
+        landmarks->mutable_landmark()->Reserve(header.num_landmarks);
+        for (uint32_t i = 0; i < header.num_landmarks; ++i, xyz += 3 * sizeof(float))
+        {
+            float values[3];
+            std::memcpy(values, xyz, sizeof(values));
+            NormalizedLandmark* landmark = landmarks->add_landmark();
+            landmark->set_x(values[0]);
+            landmark->set_y(values[1]);
+            landmark->set_z(values[2]);
+        }
+        cc->Outputs().Tag(kLandmarksStreamTag).Add(landmarks.release(), timestamp);
+        if (cc->Outputs().HasTag(kClientIdStreamTag))
+        {
+            cc->Outputs().Tag(kClientIdStreamTag).AddPacket(MakePacket<int>(header.client_id).At(timestamp));
+        }
+    } // Emit()
+
+    absl::Status LandmarkSocketSourceCalculator::Process(CalculatorContext* cc)
+    {
+        CALCULATOR_TRACE_SCOPE("LandmarkSocketSourceCalculator", cc);
+        if (m_stop) { return tool::StatusStop(); }
+
+        struct pollfd descriptor { m_fd, POLLIN, 0 };
+        const int ready = poll(&descriptor, 1, m_options.poll_timeout_ms());
+        if (ready < 0 && errno != EINTR)
+        {
+            return absl::UnavailableError(absl::StrCat("poll failed: ", std::strerror(errno)));
+        }
+        if (ready <= 0) { return absl::OkStatus(); }
+
+        const int received = recvmmsg(m_fd, m_messages.data(), m_messages.size(), MSG_DONTWAIT, nullptr);
+        if (received < 0)
+        {
+            if (errno == EAGAIN || errno == EINTR) { return absl::OkStatus(); }
+            return absl::UnavailableError(absl::StrCat("recvmmsg failed: ", std::strerror(errno)));
+        }
+        for (int i = 0; i < received && !m_stop; ++i)
+        {
+            this->Emit(cc, static_cast<const char*>(m_iovecs[i].iov_base), m_messages[i].msg_len);
+        }
+
+        return m_stop ? tool::StatusStop(): absl::OkStatus();
+    } // Process()
+
+    absl::Status LandmarkSocketSourceCalculator::Close(CalculatorContext* cc)
+    {
+        if (m_fd >= 0)
+        {
+            close(m_fd);
+            unlink(m_options.socket_path().c_str());
+            m_fd = -1;
+        }
+        return absl::OkStatus();
+    }
+
+} // namespace mediapipe
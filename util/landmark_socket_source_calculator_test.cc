@@ -0,0 +1,172 @@
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "absl/strings/str_cat.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/calculator_runner.h"
+#include "mediapipe/framework/formats/landmark.pb.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+#include "mediapipe/framework/port/status_matchers.h"
+#include "mediapipe/calculators/custom/util/landmark_record.h"
+
+namespace mediapipe
+{
+
+    namespace
+    {
+        constexpr uint32_t kClientId = 7;
+        constexpr uint32_t kOtherClientId = 8;
+        // Attempts, 1ms apart, to reach the node before it has bound its socket
+        constexpr int kMaxBindWaitAttempts = 5000;
+
+        std::string SocketPath(const std::string& test)
+        {
+            return absl::StrCat(::testing::TempDir(), "/landmark_source_", test, "_", getpid(), ".sock");
+        }
+
+        CalculatorGraphConfig::Node SourceNode(const std::string& socket_path, int64_t client_id)
+        {
+            return ParseTextProtoOrDie<CalculatorGraphConfig::Node>(absl::StrCat(R"pb(
+                calculator: "LandmarkSocketSourceCalculator"
+                output_stream: "LANDMARKS:landmarks"
+                output_stream: "CLIENT_ID:client_id"
+                options {
+                  [mediapipe.LandmarkSocketSourceCalculatorOptions.ext] {
+                    socket_path: ")pb", socket_path, R"pb("
+                    client_id: )pb", client_id, R"pb(
+                    poll_timeout_ms: 10
+                  }
+                }
+            )pb"));
+        }
+
+        // One end of the test's socket pair, sending records to the source node
+        class Sender
+        {
+        private:
+            int m_fd;
+            struct sockaddr_un m_address {};
+            bool m_reached = false;
+
+        public:
+            explicit Sender(const std::string& socket_path)
+                : m_fd(socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0))
+            {
+                m_address.sun_family = AF_UNIX;
+                std::strncpy(m_address.sun_path, socket_path.c_str(), sizeof(m_address.sun_path) - 1);
+            }
+
+            ~Sender() { close(m_fd); }
+
+            // The first record is retried for a while until the node has bound
+            // its socket, later ones are sent once
+            void Send(uint32_t client_id, int64_t timestamp_us, std::vector<float> xyz, uint16_t flags = 0)
+            {
+                LandmarkRecordHeader header { kLandmarkRecordMagic, kLandmarkRecordVersion, flags,
+                                              client_id, static_cast<uint32_t>(xyz.size() / 3), timestamp_us };
+                std::string record(reinterpret_cast<const char*>(&header), sizeof(header));
+                record.append(reinterpret_cast<const char*>(xyz.data()), xyz.size() * sizeof(float));
+
+                const int max_attempts = m_reached ? 1: kMaxBindWaitAttempts;
+                for (int attempt = 0; attempt < max_attempts; ++attempt)
+                {
+                    if (sendto(m_fd, record.data(), record.size(), 0,
+                               reinterpret_cast<const struct sockaddr*>(&m_address), sizeof(m_address)) >= 0)
+                    {
+                        m_reached = true;
+                        return;
+                    }
+                    if (errno != ENOENT && errno != ECONNREFUSED) { break; }
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                ADD_FAILURE() << "Could not send the record at " << timestamp_us << ": " << std::strerror(errno);
+            }
+
+            void SendEndOfStream(uint32_t client_id, int64_t timestamp_us)
+            {
+                this->Send(client_id, timestamp_us, {}, kLandmarkRecordEndOfStream);
+            }
+        };
+
+        // Joins on every exit path, including a failed ASSERT in the test body
+        class ScopedThread
+        {
+        private:
+            std::thread m_thread;
+
+        public:
+            template <typename Fn>
+            explicit ScopedThread(Fn&& fn)
+                : m_thread(std::forward<Fn>(fn))
+            {}
+
+            ~ScopedThread() { this->Join(); }
+
+            void Join()
+            {
+                if (m_thread.joinable()) { m_thread.join(); }
+            }
+        };
+    } // namespace
+
+    TEST(LandmarkSocketSourceCalculatorTest, EmitsOrderedRecordsAndStopsOnEndOfStream)
+    {
+        const std::string socket_path = SocketPath("ordered");
+        CalculatorRunner runner(SourceNode(socket_path, kClientId));
+
+        ScopedThread sender_thread([&socket_path] {
+            Sender sender(socket_path);
+            sender.Send(kClientId, 1000, {0.1f, 0.2f, 0.3f});
+            sender.Send(kClientId, 2000, {0.4f, 0.5f, 0.6f, 0.7f, 0.8f, 0.9f});
+            // Stale: not newer than the last emitted record
+            sender.Send(kClientId, 2000, {1.0f, 1.0f, 1.0f});
+            sender.Send(kClientId, 1500, {1.0f, 1.0f, 1.0f});
+            // Another client, its clock and its end of stream are ignored
+            sender.Send(kOtherClientId, 99000, {1.0f, 1.0f, 1.0f});
+            sender.SendEndOfStream(kOtherClientId, 99001);
+            sender.Send(kClientId, 3000, {0.0f, 0.0f, 0.0f});
+            // Nothing follows, the node closes its socket once it reads this
+            sender.SendEndOfStream(kClientId, 3001);
+        });
+        MP_ASSERT_OK(runner.Run());
+        sender_thread.Join();
+
+        const auto& packets = runner.Outputs().Tag("LANDMARKS").packets;
+        ASSERT_EQ(packets.size(), 3u);
+        EXPECT_EQ(packets[0].Timestamp(), Timestamp(1000));
+        EXPECT_EQ(packets[1].Timestamp(), Timestamp(2000));
+        EXPECT_EQ(packets[2].Timestamp(), Timestamp(3000));
+
+        const auto& second = packets[1].Get<NormalizedLandmarkList>();
+        ASSERT_EQ(second.landmark_size(), 2);
+        EXPECT_FLOAT_EQ(second.landmark(1).x(), 0.7f);
+        EXPECT_FLOAT_EQ(second.landmark(1).z(), 0.9f);
+
+        const auto& client_ids = runner.Outputs().Tag("CLIENT_ID").packets;
+        ASSERT_EQ(client_ids.size(), 3u);
+        EXPECT_EQ(client_ids[2].Get<int>(), kClientId);
+    }
+
+    TEST(LandmarkSocketSourceCalculatorTest, RequiresClientId)
+    {
+        CalculatorRunner runner(SourceNode(SocketPath("no_client"), -1));
+        EXPECT_FALSE(runner.Run().ok());
+    }
+
+    TEST(LandmarkSocketSourceCalculatorTest, FailsWhenSocketCannotBeBound)
+    {
+        CalculatorRunner runner(SourceNode("/nonexistent_directory/landmarks.sock", kClientId));
+        EXPECT_FALSE(runner.Run().ok());
+    }
+
+} // namespace mediapipe
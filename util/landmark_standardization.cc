@@ -6,15 +6,30 @@
 #include "mediapipe/framework/formats/landmark.pb.h"
 #include "mediapipe/framework/formats/detection.pb.h"
 #include "mediapipe/framework/port/opencv_core_inc.h"
+#include "mediapipe/calculators/custom/util/arena_packet.h"
+#include "mediapipe/calculators/custom/util/landmark_tensor.h"
+#include "mediapipe/calculators/custom/util/calculator_trace.h"
+#include "mediapipe/calculators/custom/util/stateless_calculator.h"
 
 namespace mediapipe
 {
+
+    namespace
+    {
+        // One arena block holds a full 478-point face mesh
+        constexpr size_t kLandmarkArenaBlockSize =
+            478 * (sizeof(NormalizedLandmark) + sizeof(void*)) + 1024;
+    } // namespace
+
     /**
      * @brief Detect face orientations from Standardized Landmarks
      * 
      * INPUTS:
      *      IMAGE - Reference Image, serves as tick signal
      *      0 - Standardized Landmarks (NormalizedLandmarkList)
+     *      TENSORS - Alternative to 0, face mesh model output read in place
+     *                (std::vector<Tensor>), see LandmarkTensorReader for
+     *                LETTERBOX_PADDING, NORM_RECT and LandmarkTensorOptions
      * OUTPUTS:
      *      0 - Standardized Landmarks (NormalizedLandmarkList)
      * 
@@ -26,9 +41,21 @@ namespace mediapipe
      *   output_stream: "face_std_landmarks"
      * }
      * 
+     * node {
+     *   calculator: "LandmarkStandardizationCalculator"
+     *   input_stream: "TENSORS:face_mesh_tensors"
+     *   input_stream: "LETTERBOX_PADDING:letterbox_padding"
+     *   input_stream: "NORM_RECT:face_rect"
+     *   output_stream: "face_std_landmarks"
+     * }
+     * 
      */
     class LandmarkStandardizationCalculator: public CalculatorBase
     {
+    private:
+        ArenaPool m_arena_pool { kLandmarkArenaBlockSize };
+        LandmarkTensorReader m_tensor_reader;
+
     public:
         LandmarkStandardizationCalculator() = default;
         ~LandmarkStandardizationCalculator() override = default;
@@ -42,30 +69,53 @@ namespace mediapipe
 
     // Register the calculator to be used in the graph
     REGISTER_CALCULATOR(LandmarkStandardizationCalculator);
+    REGISTER_STATELESS_CALCULATOR(LandmarkStandardizationCalculator);
 
     absl::Status LandmarkStandardizationCalculator::GetContract(CalculatorContract* cc)
     {
-        cc->Inputs().Index(0).Set<NormalizedLandmarkList>();
+        if (LandmarkTensorReader::HasInput(cc))
+        {
+            LandmarkTensorReader::SetContract(cc);
+        }else
+        {
+            cc->Inputs().Index(0).Set<NormalizedLandmarkList>();
+        }
         cc->Outputs().Index(0).Set<NormalizedLandmarkList>();
         return absl::OkStatus();
     }
 
     absl::Status LandmarkStandardizationCalculator::Open(CalculatorContext* cc)
     {
+        m_tensor_reader.Open(cc);
+        cc->SetOffset(TimestampDiff(0));
         return absl::OkStatus();
     }
 
     absl::Status LandmarkStandardizationCalculator::Process(CalculatorContext* cc)
     {
-        auto landmarks = cc->Inputs().Index(0).Get<NormalizedLandmarkList>();
-        cv::Mat mat(landmarks.landmark_size(), 3, CV_64FC1);
-        cv::Mat norm_mat(landmarks.landmark_size(), 3, CV_64FC1);
+        CALCULATOR_TRACE_SCOPE("LandmarkStandardizationCalculator", cc);
+        const bool from_tensor = cc->Inputs().HasTag(LandmarkTensorReader::kTensorsTag);
+        const int num_landmarks = from_tensor ?
+            m_tensor_reader.NumLandmarks(cc):
+            cc->Inputs().Index(0).Get<NormalizedLandmarkList>().landmark_size();
+        cv::Mat mat(num_landmarks, 3, CV_64FC1);
+        cv::Mat norm_mat(num_landmarks, 3, CV_64FC1);
         cv::Mat mean_mat, std_mat;
 
-        for (int i = 0; i < landmarks.landmark_size(); ++i) {
-            mat.at<double>(i, 0) = landmarks.landmark(i).x();
-            mat.at<double>(i, 1) = landmarks.landmark(i).y();
-            mat.at<double>(i, 2) = landmarks.landmark(i).z();
+        auto fill = [&mat](int i, float x, float y, float z) {
+            mat.at<double>(i, 0) = x;
+            mat.at<double>(i, 1) = y;
+            mat.at<double>(i, 2) = z;
+        };
+        if (from_tensor)
+        {
+            MP_RETURN_IF_ERROR(m_tensor_reader.ForEach(cc, fill));
+        }else
+        {
+            const auto& landmarks = cc->Inputs().Index(0).Get<NormalizedLandmarkList>();
+            for (int i = 0; i < num_landmarks; ++i) {
+                fill(i, landmarks.landmark(i).x(), landmarks.landmark(i).y(), landmarks.landmark(i).z());
+            }
         }
 
         for (int i = 0; i < mat.cols; i++) {
@@ -73,15 +123,17 @@ namespace mediapipe
             norm_mat.col(i) = (mat.col(i) - mean_mat.at<double>(0, 0)) / std_mat.at<double>(0, 0);
         }
 
-        NormalizedLandmarkList norm_landmarks;
-        for (int i = 0; i < landmarks.landmark_size(); ++i) {
-            NormalizedLandmark* landmark = norm_landmarks.add_landmark();
+        auto arena = m_arena_pool.Acquire();
+        auto norm_landmarks = google::protobuf::Arena::CreateMessage<NormalizedLandmarkList>(arena.get());
+        norm_landmarks->mutable_landmark()->Reserve(num_landmarks);
+        for (int i = 0; i < num_landmarks; ++i) {
+            NormalizedLandmark* landmark = norm_landmarks->add_landmark();
             landmark->set_x(norm_mat.at<double>(i, 0));
             landmark->set_y(norm_mat.at<double>(i, 1));
             landmark->set_z(norm_mat.at<double>(i, 2));
         }
 
-        Packet packet = MakePacket<decltype(norm_landmarks)>(norm_landmarks).At(cc->InputTimestamp());
+        Packet packet = MakeArenaPacket(norm_landmarks, std::move(arena)).At(cc->InputTimestamp());
         cc->Outputs().Index(0).AddPacket(packet);
 
         return absl::OkStatus();
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <vector>
+
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/formats/rect.pb.h"
+#include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/framework/port/status.h"
+#include "mediapipe/calculators/custom/util/landmark_tensor.pb.h"
+
+namespace mediapipe
+{
+
+    /**
+     * @brief Read face mesh landmarks straight from the model output tensor
+     *
+     * Maps raw tensor coordinates to normalized image coordinates the way
+     * TensorsToLandmarksCalculator, LandmarkLetterboxRemovalCalculator and
+     * LandmarkProjectionCalculator would, without building a
+     * NormalizedLandmarkList. The tensor's CPU buffer is read in place.
+     *
+     * INPUTS:
+     *      TENSORS - Model output, landmarks in the first tensor (std::vector<Tensor>)
+     *      LETTERBOX_PADDING - (Optional) Padding as left, top, right, bottom (std::array<float, 4>)
+     *      NORM_RECT - (Optional) Region of interest the model ran on (NormalizedRect)
+     */
+    class LandmarkTensorReader
+    {
+    private:
+        LandmarkTensorOptions m_options;
+
+    public:
+        static constexpr char kTensorsTag[]          = "TENSORS";
+        static constexpr char kLetterboxPaddingTag[] = "LETTERBOX_PADDING";
+        static constexpr char kNormRectTag[]         = "NORM_RECT";
+
+        static bool HasInput(CalculatorContract* cc) { return cc->Inputs().HasTag(kTensorsTag); }
+
+        static void SetContract(CalculatorContract* cc)
+        {
+            cc->Inputs().Tag(kTensorsTag).Set<std::vector<Tensor>>();
+            if (cc->Inputs().HasTag(kLetterboxPaddingTag))
+            {
+                cc->Inputs().Tag(kLetterboxPaddingTag).Set<std::array<float, 4>>();
+            }
+            if (cc->Inputs().HasTag(kNormRectTag))
+            {
+                cc->Inputs().Tag(kNormRectTag).Set<NormalizedRect>();
+            }
+        }
+
+        void Open(CalculatorContext* cc) { m_options = cc->Options<LandmarkTensorOptions>(); }
+
+        // Calls fn(index, x, y, z) for every landmark, in normalized image coordinates
+        template <typename Fn>
+        absl::Status ForEach(CalculatorContext* cc, Fn&& fn) const
+        {
+            const auto& tensors = cc->Inputs().Tag(kTensorsTag).Get<std::vector<Tensor>>();
+            if (tensors.empty()) { return absl::InvalidArgumentError("Empty landmark TENSORS"); }
+            if (m_options.num_dimensions() < 3) { return absl::InvalidArgumentError("num_dimensions must be at least 3"); }
+
+            // Raw coordinates to the model input image
+            float scale_x = 1.0f / m_options.input_image_width();
+            float scale_y = 1.0f / m_options.input_image_height();
+            float offset_x = 0.0f, offset_y = 0.0f;
+            float scale_z = scale_x;
+
+            // Letterbox removal
+            if (cc->Inputs().HasTag(kLetterboxPaddingTag) && !cc->Inputs().Tag(kLetterboxPaddingTag).IsEmpty())
+            {
+                const auto& padding = cc->Inputs().Tag(kLetterboxPaddingTag).Get<std::array<float, 4>>();
+                const float width = 1.0f - padding[0] - padding[2];
+                const float height = 1.0f - padding[1] - padding[3];
+                scale_x /= width;
+                scale_y /= height;
+                scale_z /= width;
+                offset_x = -padding[0] / width;
+                offset_y = -padding[1] / height;
+            }
+
+            // Projection from the region of interest
+            float cos_r = 1.0f, sin_r = 0.0f;
+            float rect_width = 1.0f, rect_height = 1.0f, center_x = 0.5f, center_y = 0.5f;
+            if (cc->Inputs().HasTag(kNormRectTag) && !cc->Inputs().Tag(kNormRectTag).IsEmpty())
+            {
+                const auto& rect = cc->Inputs().Tag(kNormRectTag).Get<NormalizedRect>();
+                cos_r = std::cos(rect.rotation());
+                sin_r = std::sin(rect.rotation());
+                rect_width = rect.width();
+                rect_height = rect.height();
+                center_x = rect.x_center();
+                center_y = rect.y_center();
+            }
+
+            const Tensor& tensor = tensors[0];
+            auto view = tensor.GetCpuReadView();
+            const float* raw = view.buffer<float>();
+            const int stride = m_options.num_dimensions();
+            const int num_landmarks = tensor.shape().num_elements() / stride;
+            for (int i = 0; i < num_landmarks; ++i, raw += stride)
+            {
+                const float x = raw[0] * scale_x + offset_x - 0.5f;
+                const float y = raw[1] * scale_y + offset_y - 0.5f;
+                fn(i,
+                   (cos_r * x - sin_r * y) * rect_width + center_x,
+                   (sin_r * x + cos_r * y) * rect_height + center_y,
+                   raw[2] * scale_z * rect_width);
+            }
+            return absl::OkStatus();
+        }
+
+        // Number of landmarks in the current TENSORS packet
+        int NumLandmarks(CalculatorContext* cc) const
+        {
+            const auto& tensors = cc->Inputs().Tag(kTensorsTag).Get<std::vector<Tensor>>();
+            if (tensors.empty() || m_options.num_dimensions() <= 0) { return 0; }
+            return tensors[0].shape().num_elements() / m_options.num_dimensions();
+        }
+    };
+
+} // namespace mediapipe
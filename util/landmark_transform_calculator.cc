@@ -0,0 +1,187 @@
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/port/status.h"
+#include "mediapipe/framework/formats/landmark.pb.h"
+#include "mediapipe/calculators/custom/util/landmark_transform_calculator.pb.h"
+#include "mediapipe/calculators/custom/util/calculator_trace.h"
+#include "mediapipe/calculators/custom/util/stateless_calculator.h"
+
+namespace mediapipe
+{
+
+    namespace
+    {
+        constexpr char kLandmarksStreamTag[] = "LANDMARKS";
+        constexpr char kMatrixTag[]          = "MATRIX";
+
+        // Applies a row-major 4x4 homogeneous transform to n points stored as
+        // separate x, y, z arrays. Each loop is branch-free over contiguous
+        // floats so the compiler vectorizes it.
+        void TransformPoints(const std::array<float, 16>& m, int n,
+                             float* __restrict x, float* __restrict y, float* __restrict z,
+                             bool perspective_divide)
+        {
+            if (perspective_divide)
+            {
+                for (int i = 0; i < n; ++i)
+                {
+                    const float px = x[i], py = y[i], pz = z[i];
+                    const float inv_w = 1.0f / (m[12] * px + m[13] * py + m[14] * pz + m[15]);
+                    x[i] = (m[0] * px + m[1] * py + m[2]  * pz + m[3])  * inv_w;
+                    y[i] = (m[4] * px + m[5] * py + m[6]  * pz + m[7])  * inv_w;
+                    z[i] = (m[8] * px + m[9] * py + m[10] * pz + m[11]) * inv_w;
+                }
+            }else
+            {
+                for (int i = 0; i < n; ++i)
+                {
+                    const float px = x[i], py = y[i], pz = z[i];
+                    x[i] = m[0] * px + m[1] * py + m[2]  * pz + m[3];
+                    y[i] = m[4] * px + m[5] * py + m[6]  * pz + m[7];
+                    z[i] = m[8] * px + m[9] * py + m[10] * pz + m[11];
+                }
+            }
+        }
+    } // namespace
+
+    /**
+     * @brief Apply a 4x4 homogeneous transform to every landmark
+     *
+     * Consumes the matrix emitted by ConstantMatrixCalculator. Landmarks are
+     * transformed in one batch; the input list is modified in place when this
+     * node is its sole owner, otherwise it is copied once.
+     *
+     * INPUTS:
+     *      LANDMARKS - Landmarks (NormalizedLandmarkList)
+     *      MATRIX - (Optional) Row-major transform (std::array<float, 16>)
+     * INPUT SIDE PACKETS:
+     *      MATRIX - (Optional) Row-major transform (std::array<float, 16>),
+     *               used when no MATRIX stream is connected
+     * OUTPUTS:
+     *      LANDMARKS - Transformed Landmarks (NormalizedLandmarkList)
+     *
+     * Example:
+     *
+     * node {
+     *   calculator: "LandmarkTransformCalculator"
+     *   input_stream: "LANDMARKS:face_landmarks"
+     *   input_stream: "MATRIX:matrix"
+     *   output_stream: "LANDMARKS:transformed_landmarks"
+     *   node_options: {
+     *     [type.googleapis.com/mediapipe.LandmarkTransformCalculatorOptions] {
+     *       perspective_divide: true
+     *     }
+     *   }
+     * }
+     *
+     */
+    class LandmarkTransformCalculator: public CalculatorBase
+    {
+    private:
+        LandmarkTransformCalculatorOptions m_options;
+        // Planar coordinates, reused across frames
+        std::vector<float> m_x, m_y, m_z;
+
+    public:
+        LandmarkTransformCalculator() = default;
+        ~LandmarkTransformCalculator() override = default;
+
+        static absl::Status GetContract(CalculatorContract* cc);
+
+        absl::Status Open(CalculatorContext* cc) override;
+        absl::Status Process(CalculatorContext* cc) override;
+        absl::Status Close(CalculatorContext* cc) override;
+    };
+
+    // Register the calculator to be used in the graph
+    REGISTER_CALCULATOR(LandmarkTransformCalculator);
+    REGISTER_STATELESS_CALCULATOR(LandmarkTransformCalculator);
+
+    absl::Status LandmarkTransformCalculator::GetContract(CalculatorContract* cc)
+    {
+        cc->Inputs().Tag(kLandmarksStreamTag).Set<NormalizedLandmarkList>();
+        if (cc->Inputs().HasTag(kMatrixTag))
+        {
+            cc->Inputs().Tag(kMatrixTag).Set<std::array<float, 16>>();
+        }
+        if (cc->InputSidePackets().HasTag(kMatrixTag))
+        {
+            cc->InputSidePackets().Tag(kMatrixTag).Set<std::array<float, 16>>();
+        }
+        if (cc->Inputs().HasTag(kMatrixTag) == cc->InputSidePackets().HasTag(kMatrixTag))
+        {
+            return absl::InvalidArgumentError("Exactly one MATRIX input stream or side packet is required");
+        }
+        cc->Outputs().Tag(kLandmarksStreamTag).Set<NormalizedLandmarkList>();
+        return absl::OkStatus();
+    }
+
+    absl::Status LandmarkTransformCalculator::Open(CalculatorContext* cc)
+    {
+        m_options = cc->Options<LandmarkTransformCalculatorOptions>();
+        cc->SetOffset(TimestampDiff(0));
+        return absl::OkStatus();
+    }
+
+    absl::Status LandmarkTransformCalculator::Process(CalculatorContext* cc)
+    {
+        CALCULATOR_TRACE_SCOPE("LandmarkTransformCalculator", cc);
+        if (cc->Inputs().Tag(kLandmarksStreamTag).IsEmpty()) { return absl::OkStatus(); }
+
+        const std::array<float, 16>* matrix = nullptr;
+        if (cc->Inputs().HasTag(kMatrixTag))
+        {
+            if (cc->Inputs().Tag(kMatrixTag).IsEmpty()) { return absl::OkStatus(); }
+            matrix = &cc->Inputs().Tag(kMatrixTag).Get<std::array<float, 16>>();
+        }else
+        {
+            matrix = &cc->InputSidePackets().Tag(kMatrixTag).Get<std::array<float, 16>>();
+        }
+
+        std::unique_ptr<NormalizedLandmarkList> landmarks;
+        auto consumed = cc->Inputs().Tag(kLandmarksStreamTag).Value().Consume<NormalizedLandmarkList>();
+        if (consumed.ok())
+        {
+            landmarks = std::move(consumed).value();
+        }else
+        {
+            landmarks = absl::make_unique<NormalizedLandmarkList>(
+                cc->Inputs().Tag(kLandmarksStreamTag).Get<NormalizedLandmarkList>()
+            );
+        }
+
+        const int num_landmarks = landmarks->landmark_size();
+        m_x.resize(num_landmarks);
+        m_y.resize(num_landmarks);
+        m_z.resize(num_landmarks);
+        for (int i = 0; i < num_landmarks; ++i)
+        {
+            const auto& landmark = landmarks->landmark(i);
+            m_x[i] = landmark.x();
+            m_y[i] = landmark.y();
+            m_z[i] = landmark.z();
+        }
+
+        TransformPoints(*matrix, num_landmarks, m_x.data(), m_y.data(), m_z.data(), m_options.perspective_divide());
+
+        for (int i = 0; i < num_landmarks; ++i)
+        {
+            auto* landmark = landmarks->mutable_landmark(i);
+            landmark->set_x(m_x[i]);
+            landmark->set_y(m_y[i]);
+            landmark->set_z(m_z[i]);
+        }
+
+        cc->Outputs().Tag(kLandmarksStreamTag).Add(landmarks.release(), cc->InputTimestamp());
+
+        return absl::OkStatus();
+    } // Process()
+
+    absl::Status LandmarkTransformCalculator::Close(CalculatorContext* cc)
+    { return absl::OkStatus(); }
+
+} // namespace mediapipe
@@ -0,0 +1,343 @@
+#include <string>
+
+#include "absl/strings/str_cat.h"
+#include "mediapipe/calculators/core/flow_limiter_calculator.pb.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/port/status.h"
+#include "mediapipe/framework/subgraph.h"
+#include "mediapipe/calculators/custom/util/parallel_stage.pb.h"
+#include "mediapipe/calculators/custom/util/stateless_calculator.h"
+
+namespace mediapipe
+{
+
+    namespace
+    {
+        constexpr char kOutputTag[] = "OUTPUT";
+        constexpr char kInputTag[]  = "INPUT";
+        constexpr char kSelectTag[] = "SELECT";
+
+        // Replaces the stream name of a "TAG:index:name" spec, keeping its tag and index
+        std::string Rename(const std::string& spec, const std::string& name)
+        {
+            const auto colon = spec.rfind(':');
+            return colon == std::string::npos ? name: spec.substr(0, colon + 1) + name;
+        }
+    } // namespace
+
+    /**
+     * @brief Route every input of a timestamp to the same worker, round-robin
+     *
+     * INPUTS:
+     *      0..K-1 - Stage inputs (Any)
+     * OUTPUTS:
+     *      OUTPUT:r*K+i - Input i for worker r (same as input i)
+     *      SELECT - Worker chosen for the timestamp (int)
+     *
+     * Used by ParallelStageSubgraph.
+     *
+     */
+    class ParallelDemuxCalculator: public CalculatorBase
+    {
+    private:
+        int m_num_inputs = 0;
+        int m_num_workers = 0;
+        int m_next_worker = 0;
+
+    public:
+        ParallelDemuxCalculator() = default;
+        ~ParallelDemuxCalculator() override = default;
+
+        static absl::Status GetContract(CalculatorContract* cc);
+
+        absl::Status Open(CalculatorContext* cc) override;
+        absl::Status Process(CalculatorContext* cc) override;
+        absl::Status Close(CalculatorContext* cc) override;
+    };
+
+    // Register the calculator to be used in the graph
+    REGISTER_CALCULATOR(ParallelDemuxCalculator);
+
+    absl::Status ParallelDemuxCalculator::GetContract(CalculatorContract* cc)
+    {
+        const int num_inputs = cc->Inputs().NumEntries();
+        const int num_outputs = cc->Outputs().NumEntries(kOutputTag);
+        if (num_inputs == 0 || num_outputs % num_inputs != 0)
+        {
+            return absl::InvalidArgumentError("ParallelDemuxCalculator needs K inputs and a multiple of K outputs");
+        }
+        for (int i = 0; i < num_inputs; ++i)
+        {
+            cc->Inputs().Index(i).SetAny();
+        }
+        for (int j = 0; j < num_outputs; ++j)
+        {
+            cc->Outputs().Get(kOutputTag, j).SetSameAs(&cc->Inputs().Index(j % num_inputs));
+        }
+        cc->Outputs().Tag(kSelectTag).Set<int>();
+        return absl::OkStatus();
+    }
+
+    absl::Status ParallelDemuxCalculator::Open(CalculatorContext* cc)
+    {
+        m_num_inputs = cc->Inputs().NumEntries();
+        m_num_workers = cc->Outputs().NumEntries(kOutputTag) / m_num_inputs;
+        // Advances the bound of every worker not chosen for a timestamp
+        cc->SetOffset(TimestampDiff(0));
+        return absl::OkStatus();
+    }
+
+    absl::Status ParallelDemuxCalculator::Process(CalculatorContext* cc)
+    {
+        const int worker = m_next_worker;
+        m_next_worker = (m_next_worker + 1) % m_num_workers;
+
+        for (int i = 0; i < m_num_inputs; ++i)
+        {
+            const auto& packet = cc->Inputs().Index(i).Value();
+            if (!packet.IsEmpty())
+            {
+                cc->Outputs().Get(kOutputTag, worker * m_num_inputs + i).AddPacket(packet);
+            }
+        }
+        cc->Outputs().Tag(kSelectTag).AddPacket(MakePacket<int>(worker).At(cc->InputTimestamp()));
+
+        return absl::OkStatus();
+    } // Process()
+
+    absl::Status ParallelDemuxCalculator::Close(CalculatorContext* cc)
+    { return absl::OkStatus(); }
+
+    /**
+     * @brief Reassemble worker outputs in timestamp order
+     *
+     * Waits only for the worker selected at each timestamp, so a slow frame
+     * on one worker does not hold back the others' processing, while outputs
+     * still leave in input order.
+     *
+     * INPUTS:
+     *      INPUT:r - Output of worker r (Any)
+     *      SELECT - Worker chosen for the timestamp (int)
+     * OUTPUTS:
+     *      OUTPUT - Ordered stage output (same as INPUT)
+     *
+     * Used by ParallelStageSubgraph.
+     *
+     */
+    class ParallelMuxCalculator: public CalculatorBase
+    {
+    public:
+        ParallelMuxCalculator() = default;
+        ~ParallelMuxCalculator() override = default;
+
+        static absl::Status GetContract(CalculatorContract* cc);
+
+        absl::Status Open(CalculatorContext* cc) override;
+        absl::Status Process(CalculatorContext* cc) override;
+        absl::Status Close(CalculatorContext* cc) override;
+    };
+
+    // Register the calculator to be used in the graph
+    REGISTER_CALCULATOR(ParallelMuxCalculator);
+
+    absl::Status ParallelMuxCalculator::GetContract(CalculatorContract* cc)
+    {
+        cc->Inputs().Tag(kSelectTag).Set<int>();
+        for (int r = 0; r < cc->Inputs().NumEntries(kInputTag); ++r)
+        {
+            cc->Inputs().Get(kInputTag, r).SetAny();
+        }
+        cc->Outputs().Tag(kOutputTag).SetSameAs(&cc->Inputs().Get(kInputTag, 0));
+        cc->SetInputStreamHandler("MuxInputStreamHandler");
+        return absl::OkStatus();
+    }
+
+    absl::Status ParallelMuxCalculator::Open(CalculatorContext* cc)
+    {
+        cc->SetOffset(TimestampDiff(0));
+        return absl::OkStatus();
+    }
+
+    absl::Status ParallelMuxCalculator::Process(CalculatorContext* cc)
+    {
+        if (cc->Inputs().Tag(kSelectTag).IsEmpty()) { return absl::OkStatus(); }
+
+        const int worker = cc->Inputs().Tag(kSelectTag).Get<int>();
+        const auto& packet = cc->Inputs().Get(kInputTag, worker).Value();
+        if (!packet.IsEmpty())
+        {
+            cc->Outputs().Tag(kOutputTag).AddPacket(packet);
+        }
+
+        return absl::OkStatus();
+    } // Process()
+
+    absl::Status ParallelMuxCalculator::Close(CalculatorContext* cc)
+    { return absl::OkStatus(); }
+
+    /**
+     * @brief Run a stateless calculator on several frames at once
+     *
+     * Expands into a demux, `num_workers` instances of the calculator and one
+     * ordering mux per output, so per-frame work overlaps while every output
+     * stream keeps the input order. The node's streams and side packets are
+     * passed to each instance unchanged. Only calculators declared with
+     * REGISTER_STATELESS_CALCULATOR are accepted, and not with a GATE or
+     * CONFIG input: both make them stateful, and each replica would only see
+     * the packets of the frames routed to it.
+     *
+     * With `max_in_flight` set, a FlowLimiterCalculator admits frames ahead of
+     * the stage and DROPS every frame arriving while `max_in_flight` frames are
+     * in flight and `max_in_queue` are already waiting; with the default
+     * `max_in_queue` of 0 nothing waits. Leave `max_in_flight` at 0 when every
+     * frame must be processed.
+     *
+     * Example:
+     *
+     * node {
+     *   calculator: "ParallelStageSubgraph"
+     *   input_stream: "face_landmarks"
+     *   output_stream: "face_std_landmarks"
+     *   node_options: {
+     *     [type.googleapis.com/mediapipe.ParallelStageOptions] {
+     *       calculator: "LandmarkStandardizationCalculator"
+     *       num_workers: 4
+     *       max_in_flight: 8
+     *     }
+     *   }
+     * }
+     *
+     */
+    class ParallelStageSubgraph: public Subgraph
+    {
+    public:
+        absl::StatusOr<CalculatorGraphConfig> GetConfig(const SubgraphOptions& options) override;
+    };
+
+    REGISTER_MEDIAPIPE_GRAPH(ParallelStageSubgraph);
+
+    absl::StatusOr<CalculatorGraphConfig> ParallelStageSubgraph::GetConfig(const SubgraphOptions& options)
+    {
+        const auto stage_options = Subgraph::GetOptions<ParallelStageOptions>(options);
+        if (!StatelessCalculatorRegistry::IsRegistered(stage_options.calculator()))
+        {
+            return absl::InvalidArgumentError(absl::StrCat(
+                "ParallelStageSubgraph: ", stage_options.calculator(), " is not declared stateless"
+            ));
+        }
+        if (stage_options.num_workers() < 1)
+        {
+            return absl::InvalidArgumentError("ParallelStageSubgraph: num_workers must be positive");
+        }
+        // Both keep state across frames, which would diverge between replicas
+        for (const auto& spec: options.input_stream())
+        {
+            for (const char* tag: {"GATE", "CONFIG"})
+            {
+                if (spec.rfind(absl::StrCat(tag, ":"), 0) == 0)
+                {
+                    return absl::InvalidArgumentError(absl::StrCat(
+                        "ParallelStageSubgraph: ", tag, " makes the calculator stateful"
+                    ));
+                }
+            }
+        }
+        if (options.output_stream_size() == 0)
+        {
+            return absl::InvalidArgumentError("ParallelStageSubgraph: at least one output stream is required");
+        }
+
+        const int num_inputs = options.input_stream_size();
+        const int num_outputs = options.output_stream_size();
+        const int num_workers = stage_options.num_workers();
+
+        CalculatorGraphConfig config;
+        for (int i = 0; i < num_inputs; ++i)
+        {
+            config.add_input_stream(Rename(options.input_stream(i), absl::StrCat("in_", i)));
+        }
+        for (int j = 0; j < num_outputs; ++j)
+        {
+            config.add_output_stream(Rename(options.output_stream(j), absl::StrCat("out_", j)));
+        }
+        for (int s = 0; s < options.input_side_packet_size(); ++s)
+        {
+            config.add_input_side_packet(Rename(options.input_side_packet(s), absl::StrCat("side_", s)));
+        }
+
+        // Optional admission control, released by the first ordered output
+        std::string stage_input_prefix = "in_";
+        if (stage_options.max_in_flight() > 0)
+        {
+            auto* limiter = config.add_node();
+            limiter->set_calculator("FlowLimiterCalculator");
+            for (int i = 0; i < num_inputs; ++i)
+            {
+                limiter->add_input_stream(absl::StrCat("in_", i));
+                limiter->add_output_stream(absl::StrCat("limited_in_", i));
+            }
+            limiter->add_input_stream("FINISHED:out_0");
+            auto* finished = limiter->add_input_stream_info();
+            finished->set_tag_index("FINISHED");
+            finished->set_back_edge(true);
+
+            FlowLimiterCalculatorOptions limiter_options;
+            limiter_options.set_max_in_flight(stage_options.max_in_flight());
+            limiter_options.set_max_in_queue(stage_options.max_in_queue());
+            limiter->add_node_options()->PackFrom(limiter_options);
+            stage_input_prefix = "limited_in_";
+        }
+
+        auto* demux = config.add_node();
+        demux->set_calculator("ParallelDemuxCalculator");
+        for (int i = 0; i < num_inputs; ++i)
+        {
+            demux->add_input_stream(absl::StrCat(stage_input_prefix, i));
+        }
+        for (int r = 0; r < num_workers; ++r)
+        {
+            for (int i = 0; i < num_inputs; ++i)
+            {
+                demux->add_output_stream(absl::StrCat(kOutputTag, ":", r * num_inputs + i, ":w", r, "_in_", i));
+            }
+        }
+        demux->add_output_stream(absl::StrCat(kSelectTag, ":select"));
+
+        for (int r = 0; r < num_workers; ++r)
+        {
+            auto* worker = config.add_node();
+            worker->set_calculator(stage_options.calculator());
+            for (int i = 0; i < num_inputs; ++i)
+            {
+                worker->add_input_stream(Rename(options.input_stream(i), absl::StrCat("w", r, "_in_", i)));
+            }
+            for (int j = 0; j < num_outputs; ++j)
+            {
+                worker->add_output_stream(Rename(options.output_stream(j), absl::StrCat("w", r, "_out_", j)));
+            }
+            for (int s = 0; s < options.input_side_packet_size(); ++s)
+            {
+                worker->add_input_side_packet(Rename(options.input_side_packet(s), absl::StrCat("side_", s)));
+            }
+            for (const auto& node_options: stage_options.node_options())
+            {
+                *worker->add_node_options() = node_options;
+            }
+        }
+
+        for (int j = 0; j < num_outputs; ++j)
+        {
+            auto* mux = config.add_node();
+            mux->set_calculator("ParallelMuxCalculator");
+            for (int r = 0; r < num_workers; ++r)
+            {
+                mux->add_input_stream(absl::StrCat(kInputTag, ":", r, ":w", r, "_out_", j));
+            }
+            mux->add_input_stream(absl::StrCat(kSelectTag, ":select"));
+            mux->add_output_stream(absl::StrCat(kOutputTag, ":out_", j));
+        }
+
+        return config;
+    } // GetConfig()
+
+} // namespace mediapipe
@@ -0,0 +1,118 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+#include "mediapipe/framework/port/status_matchers.h"
+#include "mediapipe/framework/tool/sink.h"
+#include "mediapipe/calculators/custom/util/stateless_calculator.h"
+
+namespace mediapipe
+{
+
+    namespace
+    {
+        constexpr int kNumFrames = 24;
+        constexpr int kNumWorkers = 4;
+
+        std::atomic<int> g_running { 0 };
+        std::atomic<int> g_max_running { 0 };
+
+        // Doubles its input; earlier frames of each group of workers sleep
+        // longer, so frames finish out of order across the workers
+        class SlowDoubleCalculator: public CalculatorBase
+        {
+        public:
+            static absl::Status GetContract(CalculatorContract* cc)
+            {
+                cc->Inputs().Index(0).Set<int>();
+                cc->Outputs().Index(0).Set<int>();
+                return absl::OkStatus();
+            }
+
+            absl::Status Process(CalculatorContext* cc) override
+            {
+                const int running = ++g_running;
+                int max_running = g_max_running.load();
+                while (running > max_running && !g_max_running.compare_exchange_weak(max_running, running)) {}
+
+                const int value = cc->Inputs().Index(0).Get<int>();
+                std::this_thread::sleep_for(std::chrono::milliseconds(5 * (kNumWorkers - value % kNumWorkers)));
+                cc->Outputs().Index(0).AddPacket(MakePacket<int>(2 * value).At(cc->InputTimestamp()));
+
+                --g_running;
+                return absl::OkStatus();
+            }
+        };
+
+        REGISTER_CALCULATOR(SlowDoubleCalculator);
+        REGISTER_STATELESS_CALCULATOR(SlowDoubleCalculator);
+
+        CalculatorGraphConfig StageConfig(const std::string& input_stream)
+        {
+            return ParseTextProtoOrDie<CalculatorGraphConfig>(absl::StrCat(R"pb(
+                input_stream: "in"
+                output_stream: "out"
+                num_threads: 8
+                node {
+                  calculator: "ParallelStageSubgraph"
+                  input_stream: ")pb", input_stream, R"pb("
+                  output_stream: "out"
+                  node_options: {
+                    [type.googleapis.com/mediapipe.ParallelStageOptions] {
+                      calculator: "SlowDoubleCalculator"
+                      num_workers: 4
+                    }
+                  }
+                }
+            )pb"));
+        }
+    } // namespace
+
+    TEST(ParallelStageSubgraphTest, KeepsInputOrderWhenWorkersFinishOutOfOrder)
+    {
+        CalculatorGraphConfig config = StageConfig("in");
+        std::vector<Packet> outputs;
+        tool::AddVectorSink("out", &config, &outputs);
+
+        CalculatorGraph graph;
+        MP_ASSERT_OK(graph.Initialize(config));
+        MP_ASSERT_OK(graph.StartRun({}));
+        for (int i = 0; i < kNumFrames; ++i)
+        {
+            MP_ASSERT_OK(graph.AddPacketToInputStream("in", MakePacket<int>(i).At(Timestamp(i * 1000))));
+        }
+        MP_ASSERT_OK(graph.CloseAllInputStreams());
+        MP_ASSERT_OK(graph.WaitUntilDone());
+
+        ASSERT_EQ(outputs.size(), kNumFrames);
+        for (int i = 0; i < kNumFrames; ++i)
+        {
+            EXPECT_EQ(outputs[i].Timestamp(), Timestamp(i * 1000));
+            EXPECT_EQ(outputs[i].Get<int>(), 2 * i);
+        }
+        // The workers really ran concurrently
+        EXPECT_GT(g_max_running.load(), 1);
+    }
+
+    TEST(ParallelStageSubgraphTest, RejectsGateInput)
+    {
+        CalculatorGraphConfig config = StageConfig("GATE:in");
+        CalculatorGraph graph;
+        EXPECT_FALSE(graph.Initialize(config).ok());
+    }
+
+    TEST(ParallelStageSubgraphTest, RejectsConfigInput)
+    {
+        CalculatorGraphConfig config = StageConfig("CONFIG:in");
+        CalculatorGraph graph;
+        EXPECT_FALSE(graph.Initialize(config).ok());
+    }
+
+} // namespace mediapipe
@@ -0,0 +1,316 @@
+#include <algorithm>
+#include <cstdint>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/port/status.h"
+#include "mediapipe/framework/port/logging.h"
+#include "mediapipe/framework/formats/landmark.pb.h"
+#include "mediapipe/calculators/custom/util/proctor_result.h"
+#include "mediapipe/calculators/custom/util/proctor_history_calculator.pb.h"
+#include "mediapipe/calculators/custom/util/calculator_trace.h"
+
+namespace mediapipe
+{
+
+    namespace
+    {
+        constexpr char kLandmarksStreamTag[] = "LANDMARKS";
+        constexpr char kResultStreamTag[]    = "RESULT";
+        constexpr char kTriggerStreamTag[]   = "TRIGGER";
+
+        struct FrameRecord
+        {
+            int64_t timestamp_us = 0;
+            bool has_result = false;
+            ProctorResult result {};
+            int num_landmarks = 0;
+        };
+
+        // Frames around one trigger, copied out of the ring for the writer thread
+        struct EventSnapshot
+        {
+            std::string path;
+            int landmark_stride = 0;
+            std::vector<FrameRecord> frames;
+            std::vector<float> landmarks;
+        };
+
+        void WriteSnapshot(const EventSnapshot& snapshot)
+        {
+            std::ofstream out(snapshot.path);
+            out << "timestamp_us,left_eye_blinking,right_eye_blinking,horizontal_align,"
+                   "vertical_align,facial_activity,face_movement,num_landmarks,landmarks_xyz\n";
+            for (size_t f = 0; f < snapshot.frames.size(); ++f)
+            {
+                const auto& frame = snapshot.frames[f];
+                out << frame.timestamp_us;
+                if (frame.has_result)
+                {
+                    out << ',' << frame.result.is_left_eye_blinking
+                        << ',' << frame.result.is_right_eye_blinking
+                        << ',' << frame.result.horizontal_align
+                        << ',' << frame.result.vertical_align
+                        << ',' << frame.result.facial_activity
+                        << ',' << frame.result.face_movement;
+                }else
+                {
+                    out << ",,,,,,";
+                }
+                out << ',' << frame.num_landmarks;
+                const float* xyz = snapshot.landmarks.data() + f * snapshot.landmark_stride;
+                for (int i = 0; i < frame.num_landmarks * 3; ++i) { out << ',' << xyz[i]; }
+                out << '\n';
+            }
+            if (!out) { LOG(ERROR) << "Failed writing proctor event snapshot " << snapshot.path; }
+        }
+    } // namespace
+
+    /**
+     * @brief Keep recent landmarks and results, export the context of flagged events
+     *
+     * Records every frame into a fixed-size ring of preallocated slots. On a
+     * rising edge of TRIGGER, the frames from `pre_event_us` before to
+     * `post_event_us` after the trigger are written to a CSV file on a
+     * background thread once the post-event window has been recorded.
+     * Triggers inside a pending window extend it instead of exporting twice,
+     * up to `max_window_us`; a later trigger closes it and opens a new one.
+     *
+     * INPUTS:
+     *      LANDMARKS - (Optional) Landmarks (NormalizedLandmarkList)
+     *      RESULT - (Optional) Proctor Result (ProctorResult)
+     *      TRIGGER - Export the surrounding window on a false to true change (bool)
+     *
+     * Example:
+     *
+     * node {
+     *   calculator: "ProctorHistoryCalculator"
+     *   input_stream: "LANDMARKS:face_landmarks"
+     *   input_stream: "RESULT:proctor_result"
+     *   input_stream: "TRIGGER:violation"
+     *   node_options: {
+     *     [type.googleapis.com/mediapipe.ProctorHistoryCalculatorOptions] {
+     *       capacity: 600
+     *       output_directory: "/var/proctor/events"
+     *     }
+     *   }
+     * }
+     *
+     */
+    class ProctorHistoryCalculator: public CalculatorBase
+    {
+    private:
+        struct PendingEvent
+        {
+            int64_t trigger_us;
+            int64_t end_us;
+        };
+
+        ProctorHistoryCalculatorOptions m_options;
+        int m_landmark_stride = 0;
+
+        // Ring of recent frames, m_next_slot is the oldest once full
+        std::vector<FrameRecord> m_records;
+        std::vector<float> m_landmarks;
+        int m_next_slot = 0;
+        int m_num_records = 0;
+
+        bool m_was_triggered = false;
+        std::deque<PendingEvent> m_pending;
+
+        // Background writer
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        std::deque<std::unique_ptr<EventSnapshot>> m_queue;
+        bool m_stopping = false;
+        std::thread m_writer;
+
+        void Record(CalculatorContext* cc);
+        void Export(const PendingEvent& event);
+        void WriterLoop();
+
+    public:
+        ProctorHistoryCalculator() = default;
+        ~ProctorHistoryCalculator() override = default;
+
+        static absl::Status GetContract(CalculatorContract* cc);
+
+        absl::Status Open(CalculatorContext* cc) override;
+        absl::Status Process(CalculatorContext* cc) override;
+        absl::Status Close(CalculatorContext* cc) override;
+    };
+
+    // Register the calculator to be used in the graph
+    REGISTER_CALCULATOR(ProctorHistoryCalculator);
+
+    absl::Status ProctorHistoryCalculator::GetContract(CalculatorContract* cc)
+    {
+        if (cc->Inputs().HasTag(kLandmarksStreamTag))
+        {
+            cc->Inputs().Tag(kLandmarksStreamTag).Set<NormalizedLandmarkList>();
+        }
+        if (cc->Inputs().HasTag(kResultStreamTag))
+        {
+            cc->Inputs().Tag(kResultStreamTag).Set<ProctorResult>();
+        }
+        cc->Inputs().Tag(kTriggerStreamTag).Set<bool>();
+        return absl::OkStatus();
+    }
+
+    absl::Status ProctorHistoryCalculator::Open(CalculatorContext* cc)
+    {
+        m_options = cc->Options<ProctorHistoryCalculatorOptions>();
+        if (m_options.capacity() <= 0 || m_options.max_landmarks() < 0)
+        {
+            return absl::InvalidArgumentError("ProctorHistoryCalculator needs a positive capacity");
+        }
+
+        m_landmark_stride = m_options.max_landmarks() * 3;
+        m_records.resize(m_options.capacity());
+        m_landmarks.resize(static_cast<size_t>(m_options.capacity()) * m_landmark_stride);
+        m_writer = std::thread(&ProctorHistoryCalculator::WriterLoop, this);
+        return absl::OkStatus();
+    }
+
+    void ProctorHistoryCalculator::Record(CalculatorContext* cc)
+    {
+        FrameRecord& record = m_records[m_next_slot];
+        record.timestamp_us = cc->InputTimestamp().Microseconds();
+        record.has_result = cc->Inputs().HasTag(kResultStreamTag) && !cc->Inputs().Tag(kResultStreamTag).IsEmpty();
+        if (record.has_result)
+        {
+            record.result = cc->Inputs().Tag(kResultStreamTag).Get<ProctorResult>();
+        }
+
+        record.num_landmarks = 0;
+        if (cc->Inputs().HasTag(kLandmarksStreamTag) && !cc->Inputs().Tag(kLandmarksStreamTag).IsEmpty())
+        {
+            const auto& landmarks = cc->Inputs().Tag(kLandmarksStreamTag).Get<NormalizedLandmarkList>();
+            record.num_landmarks = std::min(landmarks.landmark_size(), m_options.max_landmarks());
+            float* xyz = m_landmarks.data() + static_cast<size_t>(m_next_slot) * m_landmark_stride;
+            for (int i = 0; i < record.num_landmarks; ++i, xyz += 3)
+            {
+                const auto& landmark = landmarks.landmark(i);
+                xyz[0] = landmark.x();
+                xyz[1] = landmark.y();
+                xyz[2] = landmark.z();
+            }
+        }
+
+        m_next_slot = (m_next_slot + 1) % m_options.capacity();
+        m_num_records = std::min(m_num_records + 1, m_options.capacity());
+    } // Record()
+
+    void ProctorHistoryCalculator::Export(const PendingEvent& event)
+    {
+        auto snapshot = absl::make_unique<EventSnapshot>();
+        snapshot->path = absl::StrCat(
+            m_options.output_directory(), "/", m_options.file_prefix(), "_", event.trigger_us, ".csv"
+        );
+        snapshot->landmark_stride = m_landmark_stride;
+
+        const int64_t begin_us = event.trigger_us - m_options.pre_event_us();
+        const int capacity = m_options.capacity();
+        const int oldest = (m_next_slot - m_num_records + capacity) % capacity;
+        for (int n = 0; n < m_num_records; ++n)
+        {
+            const int slot = (oldest + n) % capacity;
+            const auto& record = m_records[slot];
+            if (record.timestamp_us < begin_us || record.timestamp_us > event.end_us) { continue; }
+
+            snapshot->frames.push_back(record);
+            const float* xyz = m_landmarks.data() + static_cast<size_t>(slot) * m_landmark_stride;
+            snapshot->landmarks.insert(snapshot->landmarks.end(), xyz, xyz + m_landmark_stride);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_queue.push_back(std::move(snapshot));
+        }
+        m_condition.notify_one();
+    } // Export()
+
+    void ProctorHistoryCalculator::WriterLoop()
+    {
+        for (;;)
+        {
+            std::unique_ptr<EventSnapshot> snapshot;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_condition.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+                if (m_queue.empty()) { return; }
+                snapshot = std::move(m_queue.front());
+                m_queue.pop_front();
+            }
+            WriteSnapshot(*snapshot);
+        }
+    } // WriterLoop()
+
+    absl::Status ProctorHistoryCalculator::Process(CalculatorContext* cc)
+    {
+        CALCULATOR_TRACE_SCOPE("ProctorHistoryCalculator", cc);
+        this->Record(cc);
+
+        const int64_t now_us = cc->InputTimestamp().Microseconds();
+        const bool is_triggered = !cc->Inputs().Tag(kTriggerStreamTag).IsEmpty() &&
+                                  cc->Inputs().Tag(kTriggerStreamTag).Get<bool>();
+        if (is_triggered && !m_was_triggered)
+        {
+            const int64_t end_us = now_us + m_options.post_event_us();
+            if (!m_pending.empty() && now_us <= m_pending.back().end_us)
+            {
+                auto& open_event = m_pending.back();
+                if (end_us - (open_event.trigger_us - m_options.pre_event_us()) <= m_options.max_window_us())
+                {
+                    open_event.end_us = end_us;
+                }else
+                {
+                    // Longer windows would lose their oldest frames to the ring,
+                    // close this one here and start over from this trigger
+                    open_event.end_us = now_us;
+                    m_pending.push_back({now_us, end_us});
+                }
+            }else
+            {
+                m_pending.push_back({now_us, end_us});
+            }
+        }
+        m_was_triggered = is_triggered;
+
+        while (!m_pending.empty() && m_pending.front().end_us <= now_us)
+        {
+            this->Export(m_pending.front());
+            m_pending.pop_front();
+        }
+
+        return absl::OkStatus();
+    } // Process()
+
+    absl::Status ProctorHistoryCalculator::Close(CalculatorContext* cc)
+    {
+        // Export cut-short windows too
+        for (const auto& event: m_pending) { this->Export(event); }
+        m_pending.clear();
+
+        if (m_writer.joinable())
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stopping = true;
+            }
+            m_condition.notify_one();
+            m_writer.join();
+        }
+        return absl::OkStatus();
+    }
+
+} // namespace mediapipe
@@ -5,6 +5,8 @@
 #include "mediapipe/calculators/core/end_loop_calculator.h"
 #include "mediapipe/calculators/core/begin_loop_calculator.h"
 #include "proctor_result.h"
+#include "mediapipe/calculators/custom/util/calculator_trace.h"
+#include "mediapipe/calculators/custom/util/stateless_calculator.h"
 
 namespace mediapipe
 {
@@ -44,6 +46,7 @@ namespace mediapipe
 
     // Register the calculator to be used in the graph
     REGISTER_CALCULATOR(ProctorResultCalculator);
+    REGISTER_STATELESS_CALCULATOR(ProctorResultCalculator);
 
     absl::Status ProctorResultCalculator::GetContract(CalculatorContract* cc)
     {
@@ -58,11 +61,13 @@ namespace mediapipe
 
     absl::Status ProctorResultCalculator::Open(CalculatorContext* cc)
     {
+        cc->SetOffset(TimestampDiff(0));
         return absl::OkStatus();
     }
 
     absl::Status ProctorResultCalculator::Process(CalculatorContext* cc)
     {
+        CALCULATOR_TRACE_SCOPE("ProctorResultCalculator", cc);
         ProctorResult result;
         auto blink = cc->Inputs().Tag("BLINK").Get<std::map<std::string, double>>();
         auto threshold = blink.at("threshold");
@@ -0,0 +1,255 @@
+#include <array>
+#include <memory>
+#include <string>
+
+#include "absl/memory/memory.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/port/status.h"
+#include "mediapipe/framework/port/opencv_core_inc.h"
+#include "mediapipe/framework/port/opencv_imgproc_inc.h"
+#include "mediapipe/framework/formats/image_frame.h"
+#include "mediapipe/framework/formats/image_format.pb.h"
+#include "mediapipe/framework/formats/image_frame_opencv.h"
+#include "mediapipe/calculators/custom/util/proctor_result.h"
+#include "mediapipe/calculators/custom/util/proctor_result_overlay_calculator.pb.h"
+#include "mediapipe/calculators/custom/util/calculator_trace.h"
+#include "mediapipe/calculators/custom/util/config_input.h"
+
+namespace mediapipe
+{
+
+    namespace
+    {
+        constexpr char kResultStreamTag[] = "RESULT";
+        constexpr char kImageStreamTag[]  = "IMAGE";
+
+        // Labels drawn by the overlay, matching ProctorResultToRenderDataCalculator
+        enum Label { kBlink = 0, kNeutral, kLeft, kRight, kUp, kDown, kNumLabels };
+        constexpr const char* kLabelTexts[kNumLabels] = {
+            "Blink", "Neutral", "Left", "Right", "Up", "Down"
+        };
+
+        // Text layout, matching ProctorResultToRenderDataCalculator
+        constexpr double kBlinkFontHeight       = 0.03;
+        constexpr int    kBlinkThickness        = 3;
+        constexpr double kBlinkBaseline         = 0.25;
+        constexpr double kOrientationFontHeight = 0.04;
+        constexpr int    kOrientationThickness  = 4;
+        constexpr double kOrientationBaseline   = 0.2;
+
+        const cv::Vec3b kGreen(0, 255, 0);
+        const cv::Vec3b kRed(255, 0, 0);
+
+        // Pre-rendered label coverage, cropped to the inked pixels
+        struct LabelGlyph
+        {
+            cv::Mat alpha;      // CV_8UC1 coverage mask
+            cv::Point offset;   // Top-left of alpha relative to the text origin
+        };
+
+        LabelGlyph RenderGlyph(const std::string& text, int pixel_height, int thickness)
+        {
+            const int font_face = cv::FONT_HERSHEY_SIMPLEX;
+            const double font_scale = cv::getFontScaleFromHeight(font_face, pixel_height, thickness);
+            int baseline = 0;
+            cv::Size text_size = cv::getTextSize(text, font_face, font_scale, thickness, &baseline);
+
+            cv::Point origin(thickness, text_size.height + thickness);
+            cv::Mat canvas = cv::Mat::zeros(
+                text_size.height + baseline + 2 * thickness,
+                text_size.width + 2 * thickness,
+                CV_8UC1
+            );
+            cv::putText(canvas, text, origin, font_face, font_scale, cv::Scalar(255), thickness, cv::LINE_AA);
+
+            LabelGlyph glyph;
+            cv::Rect ink = cv::boundingRect(canvas);
+            glyph.alpha = canvas(ink).clone();
+            glyph.offset = ink.tl() - origin;
+            return glyph;
+        }
+
+        // Blends a solid color through the glyph coverage into the image in place.
+        // The inner loop is branch-free integer math on contiguous rows so that
+        // the compiler vectorizes it.
+        template <int kChannels>
+        void BlendGlyph(cv::Mat& image, const LabelGlyph& glyph, cv::Point origin, const cv::Vec3b& color)
+        {
+            const cv::Rect target(origin + glyph.offset, glyph.alpha.size());
+            const cv::Rect clipped = target & cv::Rect(0, 0, image.cols, image.rows);
+            if (clipped.empty()) { return; }
+
+            const uint32_t r = color[0], g = color[1], b = color[2];
+            for (int y = 0; y < clipped.height; ++y)
+            {
+                const uint8_t* alpha = glyph.alpha.ptr<uint8_t>(clipped.y - target.y + y) + (clipped.x - target.x);
+                uint8_t* pixel = image.ptr<uint8_t>(clipped.y + y) + clipped.x * kChannels;
+                for (int x = 0; x < clipped.width; ++x, pixel += kChannels)
+                {
+                    const uint32_t a = alpha[x];
+                    const uint32_t inv = 255 - a;
+                    // With the +128 bias, (v + (v >> 8)) >> 8 is a rounded division by 255
+                    uint32_t v0 = pixel[0] * inv + r * a + 128;
+                    uint32_t v1 = pixel[1] * inv + g * a + 128;
+                    uint32_t v2 = pixel[2] * inv + b * a + 128;
+                    pixel[0] = static_cast<uint8_t>((v0 + (v0 >> 8)) >> 8);
+                    pixel[1] = static_cast<uint8_t>((v1 + (v1 >> 8)) >> 8);
+                    pixel[2] = static_cast<uint8_t>((v2 + (v2 >> 8)) >> 8);
+                }
+            }
+        }
+    } // namespace
+
+    /**
+     * @brief Draw Proctor Result labels directly onto an Image Frame
+     *
+     * Draws the same labels as ProctorResultToRenderDataCalculator without going
+     * through RenderData and AnnotationOverlayCalculator. Label glyphs are rendered
+     * once per frame size into alpha masks and blended into the frame, in place
+     * when the input frame is not shared with other consumers.
+     *
+     * INPUTS:
+     *      RESULT - Proctor Result (ProctorResult)
+     *      IMAGE - Image to annotate (ImageFrame, SRGB or SRGBA)
+     *      CONFIG - (Optional) Replaces the orientation cut-offs from then on
+     *               (OrientationThresholds), see ConfigInput
+     * OUTPUTS:
+     *      IMAGE - Annotated Image (ImageFrame)
+     *
+     * Example:
+     *
+     * node {
+     *   calculator: "ProctorResultOverlayCalculator"
+     *   input_stream: "RESULT:proctor_result"
+     *   input_stream: "IMAGE:input_video"
+     *   output_stream: "IMAGE:output_video"
+     * }
+     *
+     */
+    class ProctorResultOverlayCalculator: public CalculatorBase
+    {
+    private:
+        cv::Size m_glyph_frame_size;
+        LabelGlyph m_blink_glyph;
+        std::array<LabelGlyph, kNumLabels> m_orientation_glyphs;
+        ConfigInput<OrientationThresholds> m_thresholds;
+
+        void RenderGlyphs(const cv::Size& frame_size);
+        void DrawLabel(cv::Mat& image, const LabelGlyph& glyph, double left, double baseline, const cv::Vec3b& color);
+
+    public:
+        ProctorResultOverlayCalculator() = default;
+        ~ProctorResultOverlayCalculator() override = default;
+
+        static absl::Status GetContract(CalculatorContract* cc);
+
+        absl::Status Open(CalculatorContext* cc) override;
+        absl::Status Process(CalculatorContext* cc) override;
+        absl::Status Close(CalculatorContext* cc) override;
+    };
+
+    // Register the calculator to be used in the graph
+    REGISTER_CALCULATOR(ProctorResultOverlayCalculator);
+
+    absl::Status ProctorResultOverlayCalculator::GetContract(CalculatorContract* cc)
+    {
+        cc->Inputs().Tag(kResultStreamTag).Set<ProctorResult>();
+        cc->Inputs().Tag(kImageStreamTag).Set<ImageFrame>();
+        cc->Outputs().Tag(kImageStreamTag).Set<ImageFrame>();
+        ConfigInput<OrientationThresholds>::SetContract(cc);
+        return absl::OkStatus();
+    }
+
+    absl::Status ProctorResultOverlayCalculator::Open(CalculatorContext* cc)
+    {
+        m_thresholds.Open(cc->Options<ProctorResultOverlayCalculatorOptions>().thresholds());
+        cc->SetOffset(TimestampDiff(0));
+        return absl::OkStatus();
+    }
+
+    void ProctorResultOverlayCalculator::RenderGlyphs(const cv::Size& frame_size)
+    {
+        const int blink_height = static_cast<int>(kBlinkFontHeight * frame_size.height);
+        const int orientation_height = static_cast<int>(kOrientationFontHeight * frame_size.height);
+        m_blink_glyph = RenderGlyph(kLabelTexts[kBlink], blink_height, kBlinkThickness);
+        for (int i = kNeutral; i < kNumLabels; ++i)
+        {
+            m_orientation_glyphs[i] = RenderGlyph(kLabelTexts[i], orientation_height, kOrientationThickness);
+        }
+        m_glyph_frame_size = frame_size;
+    } // RenderGlyphs()
+
+    void ProctorResultOverlayCalculator::DrawLabel(cv::Mat& image, const LabelGlyph& glyph, double left, double baseline, const cv::Vec3b& color)
+    {
+        cv::Point origin(
+            static_cast<int>(left * image.cols),
+            static_cast<int>(baseline * image.rows)
+        );
+        if (image.channels() == 4)
+        {
+            BlendGlyph<4>(image, glyph, origin, color);
+        }else
+        {
+            BlendGlyph<3>(image, glyph, origin, color);
+        }
+    } // DrawLabel()
+
+    absl::Status ProctorResultOverlayCalculator::Process(CalculatorContext* cc)
+    {
+        CALCULATOR_TRACE_SCOPE("ProctorResultOverlayCalculator", cc);
+        m_thresholds.Update(cc);
+        if (cc->Inputs().Tag(kImageStreamTag).IsEmpty()) { return absl::OkStatus(); }
+
+        // Draw in place when this node is the sole owner of the frame
+        std::unique_ptr<ImageFrame> frame;
+        auto consumed = cc->Inputs().Tag(kImageStreamTag).Value().Consume<ImageFrame>();
+        if (consumed.ok())
+        {
+            frame = std::move(consumed).value();
+        }else
+        {
+            const auto& input = cc->Inputs().Tag(kImageStreamTag).Get<ImageFrame>();
+            frame = absl::make_unique<ImageFrame>();
+            frame->CopyFrom(input, ImageFrame::kDefaultAlignmentBoundary);
+        }
+
+        if (frame->Format() != ImageFormat::SRGB && frame->Format() != ImageFormat::SRGBA)
+        {
+            return absl::InvalidArgumentError("ProctorResultOverlayCalculator only supports SRGB and SRGBA frames");
+        }
+
+        if (!cc->Inputs().Tag(kResultStreamTag).IsEmpty())
+        {
+            cv::Mat image = formats::MatView(frame.get());
+            if (image.size() != m_glyph_frame_size) { this->RenderGlyphs(image.size()); }
+
+            const auto& result = cc->Inputs().Tag(kResultStreamTag).Get<ProctorResult>();
+            if (result.is_left_eye_blinking)
+            {
+                this->DrawLabel(image, m_blink_glyph, 0.08, kBlinkBaseline, kRed);
+            }
+            if (result.is_right_eye_blinking)
+            {
+                this->DrawLabel(image, m_blink_glyph, 0.64, kBlinkBaseline, kRed);
+            }
+
+            const auto& thresholds = m_thresholds.Get();
+            Label hor_align = result.horizontal_align >= thresholds.right() ? kRight:
+                              result.horizontal_align <= thresholds.left() ? kLeft:
+                              kNeutral;
+            Label ver_align = result.vertical_align >= thresholds.down() ? kDown:
+                              result.vertical_align <= thresholds.up() ? kUp:
+                              kNeutral;
+            this->DrawLabel(image, m_orientation_glyphs[hor_align], 0.05, kOrientationBaseline, hor_align == kNeutral ? kGreen: kRed);
+            this->DrawLabel(image, m_orientation_glyphs[ver_align], 0.6, kOrientationBaseline, ver_align == kNeutral ? kGreen: kRed);
+        }
+
+        cc->Outputs().Tag(kImageStreamTag).Add(frame.release(), cc->InputTimestamp());
+
+        return absl::OkStatus();
+    } // Process()
+
+    absl::Status ProctorResultOverlayCalculator::Close(CalculatorContext* cc)
+    { return absl::OkStatus(); }
+
+} // namespace mediapipe
@@ -0,0 +1,170 @@
+#include "mediapipe/calculators/custom/util/proctor_result_ring.h"
+
+#include <climits>
+#include <ctime>
+
+#include <linux/futex.h>
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace mediapipe
+{
+
+    namespace
+    {
+        size_t RoundUpToPowerOfTwo(size_t value)
+        {
+            size_t result = 2;
+            while (result < value) { result <<= 1; }
+            return result;
+        }
+
+        long Futex(std::atomic<uint32_t>* word, int op, uint32_t value, const struct timespec* timeout)
+        {
+            return syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), op, value, timeout, nullptr, 0);
+        }
+    } // namespace
+
+    ProctorResultRing::ProctorResultRing(size_t capacity)
+        : m_slots(new Slot[RoundUpToPowerOfTwo(capacity)]),
+          m_mask(RoundUpToPowerOfTwo(capacity) - 1)
+    {}
+
+    ProctorResultRing::~ProctorResultRing()
+    {
+        int fd = m_event_fd.load();
+        if (fd >= 0) { close(fd); }
+    }
+
+    void ProctorResultRing::Publish(const ProctorResult& result, int64_t timestamp_us)
+    {
+        const uint64_t sequence = m_head.load(std::memory_order_relaxed) + 1;
+        Slot& slot = m_slots[sequence & m_mask];
+
+        slot.version.store(2 * sequence - 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.timestamp_us = timestamp_us;
+        slot.result = result;
+        slot.version.store(2 * sequence, std::memory_order_release);
+
+        m_head.store(sequence, std::memory_order_release);
+        m_futex.store(static_cast<uint32_t>(sequence), std::memory_order_seq_cst);
+        if (m_waiters.load(std::memory_order_seq_cst) > 0)
+        {
+            Futex(&m_futex, FUTEX_WAKE_PRIVATE, INT_MAX, nullptr);
+        }
+
+        int fd = m_event_fd.load(std::memory_order_acquire);
+        if (fd >= 0)
+        {
+            uint64_t one = 1;
+            // Non-blocking; a full counter only means readers are far behind
+            (void) write(fd, &one, sizeof(one));
+        }
+    } // Publish()
+
+    void ProctorResultRing::Close()
+    {
+        m_closed.store(true, std::memory_order_release);
+        m_futex.fetch_add(1, std::memory_order_release);
+        Futex(&m_futex, FUTEX_WAKE_PRIVATE, INT_MAX, nullptr);
+
+        // Wake epoll readers too, so they can notice the ring is closed
+        int fd = m_event_fd.load(std::memory_order_acquire);
+        if (fd >= 0)
+        {
+            uint64_t one = 1;
+            (void) write(fd, &one, sizeof(one));
+        }
+    } // Close()
+
+    bool ProctorResultRing::Read(uint64_t sequence, ProctorResult* result, int64_t* timestamp_us) const
+    {
+        if (sequence == 0) { return false; }
+        const Slot& slot = m_slots[sequence & m_mask];
+
+        const uint64_t version = slot.version.load(std::memory_order_acquire);
+        if (version != 2 * sequence) { return false; }
+        ProctorResult copy = slot.result;
+        int64_t timestamp = slot.timestamp_us;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.version.load(std::memory_order_relaxed) != version) { return false; }
+
+        *result = copy;
+        if (timestamp_us) { *timestamp_us = timestamp; }
+        return true;
+    } // Read()
+
+    bool ProctorResultRing::ReadLatest(ProctorResult* result, int64_t* timestamp_us, uint64_t* sequence) const
+    {
+        for (int attempt = 0; attempt < kMaxReadAttempts; ++attempt)
+        {
+            const uint64_t latest = m_head.load(std::memory_order_acquire);
+            if (latest == 0) { return false; }
+            if (this->Read(latest, result, timestamp_us))
+            {
+                if (sequence) { *sequence = latest; }
+                return true;
+            }
+        }
+        return false;
+    } // ReadLatest()
+
+    bool ProctorResultRing::WaitForNewer(uint64_t sequence, int64_t timeout_us) const
+    {
+        struct timespec deadline;
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        if (timeout_us >= 0)
+        {
+            deadline.tv_sec += timeout_us / 1000000;
+            deadline.tv_nsec += (timeout_us % 1000000) * 1000;
+            if (deadline.tv_nsec >= 1000000000) { deadline.tv_sec += 1; deadline.tv_nsec -= 1000000000; }
+        }
+
+        auto* word = const_cast<std::atomic<uint32_t>*>(&m_futex);
+        for (;;)
+        {
+            const uint32_t observed = word->load(std::memory_order_acquire);
+            if (this->LatestSequence() > sequence) { return true; }
+            if (m_closed.load(std::memory_order_acquire)) { return false; }
+
+            struct timespec remaining;
+            const struct timespec* timeout = nullptr;
+            if (timeout_us >= 0)
+            {
+                struct timespec now;
+                clock_gettime(CLOCK_MONOTONIC, &now);
+                int64_t left_ns = (deadline.tv_sec - now.tv_sec) * 1000000000LL + (deadline.tv_nsec - now.tv_nsec);
+                if (left_ns <= 0) { return false; }
+                remaining.tv_sec = left_ns / 1000000000LL;
+                remaining.tv_nsec = left_ns % 1000000000LL;
+                timeout = &remaining;
+            }
+
+            m_waiters.fetch_add(1, std::memory_order_seq_cst);
+            // Re-check after announcing ourselves so a concurrent Publish() cannot be missed
+            if (word->load(std::memory_order_seq_cst) == observed)
+            {
+                Futex(word, FUTEX_WAIT_PRIVATE, observed, timeout);
+            }
+            m_waiters.fetch_sub(1, std::memory_order_relaxed);
+        }
+    } // WaitForNewer()
+
+    int ProctorResultRing::NotificationFd()
+    {
+        int fd = m_event_fd.load(std::memory_order_acquire);
+        if (fd >= 0) { return fd; }
+
+        int created = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (created < 0) { return -1; }
+        if (!m_event_fd.compare_exchange_strong(fd, created, std::memory_order_acq_rel))
+        {
+            close(created);
+            return fd;
+        }
+        return created;
+    } // NotificationFd()
+
+} // namespace mediapipe
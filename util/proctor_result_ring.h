@@ -0,0 +1,88 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "mediapipe/calculators/custom/util/proctor_result.h"
+
+namespace mediapipe
+{
+
+    /**
+     * @brief Single-producer/multi-consumer lock-free ring of Proctor Results
+     *
+     * Written by ProctorResultRingSinkCalculator on the graph thread and read by
+     * any number of application threads. Each slot is guarded by a version
+     * counter (seqlock), so the producer never waits on readers and readers
+     * never block each other. A read only fails when the producer laps the
+     * whole ring during the copy; ReadLatest() retries a bounded number of
+     * times, so every reader call is wait-free.
+     *
+     * Sequences start at 1; 0 means nothing has been published yet.
+     *
+     * Readers can either:
+     *  - poll ReadLatest() at their own pace,
+     *  - block in WaitForNewer() (futex based, no lock taken by the producer),
+     *  - or register NotificationFd() with epoll using EPOLLIN | EPOLLET and
+     *    call ReadLatest() on wakeup. The fd must not be read, so that it can
+     *    be shared by several epoll instances.
+     */
+    class ProctorResultRing
+    {
+    private:
+        struct alignas(64) Slot
+        {
+            // 2 * sequence when complete, 2 * sequence - 1 while being written
+            std::atomic<uint64_t> version { 0 };
+            int64_t timestamp_us = 0;
+            ProctorResult result {};
+        };
+
+        std::unique_ptr<Slot[]> m_slots;
+        uint64_t m_mask;
+
+        alignas(64) std::atomic<uint64_t> m_head { 0 };
+        // Low 32 bits of m_head, used as the futex word
+        std::atomic<uint32_t> m_futex { 0 };
+        mutable std::atomic<int> m_waiters { 0 };
+        std::atomic<bool> m_closed { false };
+        std::atomic<int> m_event_fd { -1 };
+
+        // Attempts of ReadLatest() before giving up on a consistent snapshot
+        static constexpr int kMaxReadAttempts = 4;
+
+    public:
+        // Capacity is rounded up to a power of two
+        explicit ProctorResultRing(size_t capacity = 64);
+        ~ProctorResultRing();
+
+        ProctorResultRing(const ProctorResultRing&) = delete;
+        ProctorResultRing& operator=(const ProctorResultRing&) = delete;
+
+        // Producer side, must only be called from one thread at a time
+        void Publish(const ProctorResult& result, int64_t timestamp_us);
+
+        // Wakes every waiter; WaitForNewer() returns false once drained.
+        // Called by ProctorResultRingSinkCalculator when the graph closes
+        void Close();
+
+        uint64_t LatestSequence() const { return m_head.load(std::memory_order_acquire); }
+
+        // Reads the given sequence if it is still held by the ring
+        bool Read(uint64_t sequence, ProctorResult* result, int64_t* timestamp_us) const;
+
+        // Reads the most recently published result; false when nothing was
+        // published or the producer overwrote the slot on every attempt
+        bool ReadLatest(ProctorResult* result, int64_t* timestamp_us, uint64_t* sequence = nullptr) const;
+
+        // Blocks until a sequence newer than `sequence` is published, the ring
+        // is closed, or `timeout_us` elapses (negative waits forever).
+        // Returns true when a newer result is available.
+        bool WaitForNewer(uint64_t sequence, int64_t timeout_us = -1) const;
+
+        // Returns an eventfd signalled on each Publish(), created on first use
+        int NotificationFd();
+    };
+
+} // namespace mediapipe
@@ -0,0 +1,105 @@
+#include <memory>
+
+#include "absl/memory/memory.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/port/status.h"
+#include "mediapipe/calculators/custom/util/proctor_result.h"
+#include "mediapipe/calculators/custom/util/proctor_result_ring.h"
+#include "mediapipe/calculators/custom/util/allocation_profiler.h"
+#include "mediapipe/calculators/custom/util/calculator_trace.h"
+
+namespace mediapipe
+{
+
+    namespace
+    {
+        constexpr char kResultStreamTag[] = "RESULT";
+        constexpr char kRingSidePacketTag[] = "RING";
+    } // namespace
+
+    /**
+     * @brief Publish Proctor Results to application threads
+     *
+     * Writes each result into a ProctorResultRing supplied by the application,
+     * which application threads read at their own pace without ever blocking
+     * the graph. The ring is closed when the graph run ends.
+     *
+     * INPUTS:
+     *      RESULT - Proctor Result (ProctorResult)
+     * INPUT SIDE PACKETS:
+     *      RING - Destination ring (std::shared_ptr<ProctorResultRing>)
+     *
+     * Example:
+     *
+     * node {
+     *   calculator: "ProctorResultRingSinkCalculator"
+     *   input_stream: "RESULT:proctor_result"
+     *   input_side_packet: "RING:proctor_result_ring"
+     * }
+     *
+     * Application:
+     *
+     *   auto ring = std::make_shared<ProctorResultRing>();
+     *   graph.StartRun({{"proctor_result_ring", MakePacket<std::shared_ptr<ProctorResultRing>>(ring)}});
+     *   ...
+     *   uint64_t seen = 0;
+     *   while (ring->WaitForNewer(seen)) { ring->ReadLatest(&result, &timestamp_us, &seen); }
+     *
+     */
+    class ProctorResultRingSinkCalculator: public CalculatorBase
+    {
+    private:
+        std::shared_ptr<ProctorResultRing> m_ring;
+
+    public:
+        ProctorResultRingSinkCalculator() = default;
+        ~ProctorResultRingSinkCalculator() override = default;
+
+        static absl::Status GetContract(CalculatorContract* cc);
+
+        absl::Status Open(CalculatorContext* cc) override;
+        absl::Status Process(CalculatorContext* cc) override;
+        absl::Status Close(CalculatorContext* cc) override;
+    };
+
+    // Register the calculator to be used in the graph
+    REGISTER_CALCULATOR(ProctorResultRingSinkCalculator);
+    // Publishing writes into preallocated slots only
+    REGISTER_ALLOCATION_FREE_CALCULATOR(ProctorResultRingSinkCalculator);
+
+    absl::Status ProctorResultRingSinkCalculator::GetContract(CalculatorContract* cc)
+    {
+        cc->Inputs().Tag(kResultStreamTag).Set<ProctorResult>();
+        cc->InputSidePackets().Tag(kRingSidePacketTag).Set<std::shared_ptr<ProctorResultRing>>();
+        return absl::OkStatus();
+    }
+
+    absl::Status ProctorResultRingSinkCalculator::Open(CalculatorContext* cc)
+    {
+        m_ring = cc->InputSidePackets().Tag(kRingSidePacketTag).Get<std::shared_ptr<ProctorResultRing>>();
+        if (!m_ring)
+        {
+            return absl::InvalidArgumentError("ProctorResultRingSinkCalculator requires a non-null RING");
+        }
+        return absl::OkStatus();
+    }
+
+    absl::Status ProctorResultRingSinkCalculator::Process(CalculatorContext* cc)
+    {
+        CALCULATOR_TRACE_SCOPE("ProctorResultRingSinkCalculator", cc);
+        if (cc->Inputs().Tag(kResultStreamTag).IsEmpty()) { return absl::OkStatus(); }
+
+        const auto& result = cc->Inputs().Tag(kResultStreamTag).Get<ProctorResult>();
+        m_ring->Publish(result, cc->InputTimestamp().Microseconds());
+
+        return absl::OkStatus();
+    } // Process()
+
+    absl::Status ProctorResultRingSinkCalculator::Close(CalculatorContext* cc)
+    {
+        // Lets application threads blocked in WaitForNewer() drain and exit
+        if (m_ring) { m_ring->Close(); }
+        return absl::OkStatus();
+    }
+
+} // namespace mediapipe
@@ -6,7 +6,13 @@
 #include "mediapipe/framework/port/status.h"
 #include "mediapipe/util/color.pb.h"
 #include "mediapipe/util/render_data.pb.h"
+#include "mediapipe/calculators/custom/util/arena_packet.h"
 #include "mediapipe/calculators/custom/util/proctor_result.h"
+#include "mediapipe/calculators/custom/util/proctor_result_to_render_data_calculator.pb.h"
+#include "mediapipe/calculators/custom/util/calculator_trace.h"
+#include "mediapipe/calculators/custom/util/config_input.h"
+#include "mediapipe/calculators/custom/util/gated_output.h"
+#include "mediapipe/calculators/custom/util/stateless_calculator.h"
 
 namespace mediapipe
 {
@@ -22,6 +28,9 @@ namespace mediapipe
      * 
      * INPUTS:
      *      RESULT - Proctor Result (ProctorResult)
+     *      GATE - (Optional) Recompute when true, else re-emit the previous output (bool)
+     *      CONFIG - (Optional) Replaces the orientation cut-offs from then on
+     *               (OrientationThresholds), see ConfigInput
      * OUTPUTS:
      *      RENDER - Render Data to be render by OverlayRenderer (RenderData)
      * 
@@ -37,6 +46,10 @@ namespace mediapipe
     class ProctorResultToRenderDataCalculator: public CalculatorBase
     {
     private:
+        GatedOutput m_gate;
+        ConfigInput<OrientationThresholds> m_thresholds;
+        ArenaPool m_arena_pool { kRenderDataArenaBlockSize };
+
         void AnnotateBlink(RenderData& render_data, bool is_blinking, double left_pos);
         void AnnotateOrientation(RenderData& render_data, std::string orientation, double left_pos);
 
@@ -53,16 +66,23 @@ namespace mediapipe
     };
     // Register the calculator to be used in the graph
     REGISTER_CALCULATOR(ProctorResultToRenderDataCalculator);
+    REGISTER_STATELESS_CALCULATOR(ProctorResultToRenderDataCalculator);
 
     absl::Status ProctorResultToRenderDataCalculator::GetContract(CalculatorContract* cc)
     {
         cc->Inputs().Tag(kResultStreamTag).Set<ProctorResult>();
         cc->Outputs().Tag(kRenderDataStreamTag).Set<RenderData>();
+        MP_RETURN_IF_ERROR(GatedOutput::SetContract(cc));
+        ConfigInput<OrientationThresholds>::SetContract(cc);
         return absl::OkStatus();
     }
 
     absl::Status ProctorResultToRenderDataCalculator::Open(CalculatorContext* cc)
-    { return absl::OkStatus(); }
+    {
+        m_thresholds.Open(cc->Options<ProctorResultToRenderDataCalculatorOptions>().thresholds());
+        cc->SetOffset(TimestampDiff(0));
+        return absl::OkStatus();
+    }
 
 
     void ProctorResultToRenderDataCalculator::AnnotateBlink(RenderData& render_data, bool is_blinking, double left_pos)
@@ -117,24 +137,33 @@ namespace mediapipe
 
     absl::Status ProctorResultToRenderDataCalculator::Process(CalculatorContext* cc)
     {
-        RenderData render_data;
+        CALCULATOR_TRACE_SCOPE("ProctorResultToRenderDataCalculator", cc);
+        MP_RETURN_IF_ERROR(m_gate.Update(cc));
+        const bool reconfigured = m_thresholds.Update(cc);
+        if (!reconfigured && m_gate.Reemit(cc, cc->Outputs().Tag(kRenderDataStreamTag))) { return absl::OkStatus(); }
+
         if (cc->Inputs().Tag(kResultStreamTag).IsEmpty()) { return absl::OkStatus(); }
 
+        auto arena = m_arena_pool.Acquire();
+        auto render_data = google::protobuf::Arena::CreateMessage<RenderData>(arena.get());
+
         auto result = cc->Inputs().Tag(kResultStreamTag).Get<ProctorResult>();
         
-        this->AnnotateBlink(render_data, result.is_left_eye_blinking, 0.08);
-        this->AnnotateBlink(render_data, result.is_right_eye_blinking, 0.64);
+        this->AnnotateBlink(*render_data, result.is_left_eye_blinking, 0.08);
+        this->AnnotateBlink(*render_data, result.is_right_eye_blinking, 0.64);
 
-        std::string hor_align = result.horizontal_align >= 0.3 ? "Right":
-                                result.horizontal_align <= -0.3 ? "Left":
+        const auto& thresholds = m_thresholds.Get();
+        std::string hor_align = result.horizontal_align >= thresholds.right() ? "Right":
+                                result.horizontal_align <= thresholds.left() ? "Left":
                                 "Neutral";
-        std::string ver_align = result.vertical_align >= 0.6 ? "Down":
-                                result.vertical_align <= -0.05 ? "Up":
+        std::string ver_align = result.vertical_align >= thresholds.down() ? "Down":
+                                result.vertical_align <= thresholds.up() ? "Up":
                                 "Neutral";
-        this->AnnotateOrientation(render_data, hor_align, 0.05);
-        this->AnnotateOrientation(render_data, ver_align, 0.6);
+        this->AnnotateOrientation(*render_data, hor_align, 0.05);
+        this->AnnotateOrientation(*render_data, ver_align, 0.6);
         
-        Packet packet = MakePacket<decltype(render_data)>(render_data).At(cc->InputTimestamp());
+        Packet packet = MakeArenaPacket(render_data, std::move(arena)).At(cc->InputTimestamp());
+        m_gate.Remember(cc, packet);
         cc->Outputs().Tag(kRenderDataStreamTag).AddPacket(packet);
 
         return absl::OkStatus();
@@ -0,0 +1,198 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <string>
+
+namespace mediapipe
+{
+
+    /**
+     * @brief Mergeable streaming quantile sketch (DDSketch)
+     *
+     * Values are counted in logarithmic buckets, so every quantile is returned
+     * with a relative error of at most `relative_accuracy`. Negative values and
+     * values near zero are kept in their own stores.
+     *
+     * Merging adds bucket counts, which gives exactly the sketch that inserting
+     * every value into one sketch would have given. Memory is bounded by
+     * `max_buckets` per sign; past that, the buckets closest to zero are folded
+     * together, which only affects the accuracy of those smallest magnitudes.
+     */
+    class QuantileSketch
+    {
+    private:
+        double m_relative_accuracy;
+        double m_log_gamma;
+        size_t m_max_buckets;
+
+        std::map<int32_t, uint64_t> m_positive;
+        std::map<int32_t, uint64_t> m_negative;
+        uint64_t m_zero_count = 0;
+
+        uint64_t m_count = 0;
+        double m_sum = 0.0;
+        double m_min = std::numeric_limits<double>::infinity();
+        double m_max = -std::numeric_limits<double>::infinity();
+
+        static constexpr double kMinIndexableValue = 1e-9;
+
+        int32_t Index(double magnitude) const
+        {
+            return static_cast<int32_t>(std::ceil(std::log(magnitude) / m_log_gamma));
+        }
+
+        double Value(int32_t index) const
+        {
+            // Midpoint of the bucket in relative terms
+            const double gamma = std::exp(m_log_gamma);
+            return 2.0 * std::exp(index * m_log_gamma) / (gamma + 1.0);
+        }
+
+        void Collapse(std::map<int32_t, uint64_t>& store)
+        {
+            while (store.size() > m_max_buckets)
+            {
+                auto lowest = store.begin();
+                auto next = std::next(lowest);
+                next->second += lowest->second;
+                store.erase(lowest);
+            }
+        }
+
+    public:
+        explicit QuantileSketch(double relative_accuracy = 0.01, size_t max_buckets = 2048)
+            : m_relative_accuracy(relative_accuracy),
+              m_log_gamma(std::log((1.0 + relative_accuracy) / (1.0 - relative_accuracy))),
+              m_max_buckets(std::max<size_t>(max_buckets, 2))
+        {}
+
+        void Add(double value)
+        {
+            if (std::isnan(value)) { return; }
+            if (value > kMinIndexableValue)
+            {
+                ++m_positive[this->Index(value)];
+                if (m_positive.size() > m_max_buckets) { this->Collapse(m_positive); }
+            }else if (value < -kMinIndexableValue)
+            {
+                ++m_negative[this->Index(-value)];
+                if (m_negative.size() > m_max_buckets) { this->Collapse(m_negative); }
+            }else
+            {
+                ++m_zero_count;
+            }
+            ++m_count;
+            m_sum += value;
+            m_min = std::min(m_min, value);
+            m_max = std::max(m_max, value);
+        }
+
+        // Returns false when the sketches were built with different parameters
+        bool Merge(const QuantileSketch& other)
+        {
+            if (other.m_relative_accuracy != m_relative_accuracy) { return false; }
+            for (const auto& bucket: other.m_positive) { m_positive[bucket.first] += bucket.second; }
+            for (const auto& bucket: other.m_negative) { m_negative[bucket.first] += bucket.second; }
+            this->Collapse(m_positive);
+            this->Collapse(m_negative);
+            m_zero_count += other.m_zero_count;
+            m_count += other.m_count;
+            m_sum += other.m_sum;
+            m_min = std::min(m_min, other.m_min);
+            m_max = std::max(m_max, other.m_max);
+            return true;
+        }
+
+        // Value at quantile q in [0, 1], NaN when empty
+        double Quantile(double q) const
+        {
+            if (m_count == 0) { return std::numeric_limits<double>::quiet_NaN(); }
+            if (q <= 0.0) { return m_min; }
+            if (q >= 1.0) { return m_max; }
+
+            const uint64_t rank = static_cast<uint64_t>(q * (m_count - 1));
+            uint64_t seen = 0;
+            // Most negative values sit in the highest negative buckets
+            for (auto it = m_negative.rbegin(); it != m_negative.rend(); ++it)
+            {
+                seen += it->second;
+                if (seen > rank) { return std::max(m_min, -this->Value(it->first)); }
+            }
+            seen += m_zero_count;
+            if (seen > rank) { return 0.0; }
+            for (const auto& bucket: m_positive)
+            {
+                seen += bucket.second;
+                if (seen > rank) { return std::min(m_max, this->Value(bucket.first)); }
+            }
+            return m_max;
+        }
+
+        uint64_t Count() const { return m_count; }
+        double Min() const { return m_min; }
+        double Max() const { return m_max; }
+        double Mean() const { return m_count ? m_sum / m_count: std::numeric_limits<double>::quiet_NaN(); }
+        double RelativeAccuracy() const { return m_relative_accuracy; }
+
+        // Compact host-endian encoding, to persist a sketch between graph runs
+        std::string Serialize() const
+        {
+            std::string out;
+            auto put = [&out](const void* data, size_t size) {
+                out.append(static_cast<const char*>(data), size);
+            };
+            const uint64_t max_buckets = m_max_buckets;
+            const uint32_t num_positive = m_positive.size(), num_negative = m_negative.size();
+            put(&m_relative_accuracy, sizeof(m_relative_accuracy));
+            put(&max_buckets, sizeof(max_buckets));
+            put(&m_zero_count, sizeof(m_zero_count));
+            put(&m_count, sizeof(m_count));
+            put(&m_sum, sizeof(m_sum));
+            put(&m_min, sizeof(m_min));
+            put(&m_max, sizeof(m_max));
+            put(&num_positive, sizeof(num_positive));
+            put(&num_negative, sizeof(num_negative));
+            for (const auto& bucket: m_positive) { put(&bucket.first, sizeof(int32_t)); put(&bucket.second, sizeof(uint64_t)); }
+            for (const auto& bucket: m_negative) { put(&bucket.first, sizeof(int32_t)); put(&bucket.second, sizeof(uint64_t)); }
+            return out;
+        }
+
+        bool ParseFrom(const std::string& data)
+        {
+            size_t offset = 0;
+            auto get = [&data, &offset](void* value, size_t size) {
+                if (offset + size > data.size()) { return false; }
+                std::memcpy(value, data.data() + offset, size);
+                offset += size;
+                return true;
+            };
+            double relative_accuracy;
+            uint64_t max_buckets;
+            uint32_t num_positive, num_negative;
+            QuantileSketch parsed;
+            if (!get(&relative_accuracy, sizeof(relative_accuracy)) || !get(&max_buckets, sizeof(max_buckets)) ||
+                !(relative_accuracy > 0.0 && relative_accuracy < 1.0)) { return false; }
+            parsed = QuantileSketch(relative_accuracy, max_buckets);
+            if (!get(&parsed.m_zero_count, sizeof(uint64_t)) || !get(&parsed.m_count, sizeof(uint64_t)) ||
+                !get(&parsed.m_sum, sizeof(double)) || !get(&parsed.m_min, sizeof(double)) ||
+                !get(&parsed.m_max, sizeof(double)) ||
+                !get(&num_positive, sizeof(num_positive)) || !get(&num_negative, sizeof(num_negative))) { return false; }
+            for (uint32_t i = 0; i < num_positive + num_negative; ++i)
+            {
+                int32_t index;
+                uint64_t count;
+                if (!get(&index, sizeof(index)) || !get(&count, sizeof(count))) { return false; }
+                (i < num_positive ? parsed.m_positive: parsed.m_negative)[index] = count;
+            }
+            if (offset != data.size()) { return false; }
+            *this = parsed;
+            return true;
+        }
+    };
+
+} // namespace mediapipe
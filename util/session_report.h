@@ -0,0 +1,70 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "mediapipe/calculators/custom/util/quantile_sketch.h"
+
+namespace mediapipe
+{
+
+    enum OrientationState
+    {
+        ORIENTATION_NEGATIVE = 0,   // Left or Up
+        ORIENTATION_NEUTRAL,
+        ORIENTATION_POSITIVE,       // Right or Down
+        ORIENTATION_STATE_COUNT
+    };
+
+    /**
+     * @brief Bounded-memory summary of a proctoring session
+     *
+     * Built by SessionReportCalculator from every ProctorResult. Reports from
+     * several graph runs of the same session combine with Merge().
+     */
+    struct SessionReport
+    {
+        QuantileSketch horizontal_align;
+        QuantileSketch vertical_align;
+        QuantileSketch facial_activity;
+        QuantileSketch face_movement;
+
+        uint64_t frames = 0;
+        // Blinks started, i.e. open-to-closed transitions
+        uint64_t left_eye_blinks = 0;
+        uint64_t right_eye_blinks = 0;
+        // Frames spent in each orientation state
+        std::array<uint64_t, ORIENTATION_STATE_COUNT> horizontal_states {};
+        std::array<uint64_t, ORIENTATION_STATE_COUNT> vertical_states {};
+
+        SessionReport() = default;
+        SessionReport(double relative_accuracy, size_t max_buckets)
+            : horizontal_align(relative_accuracy, max_buckets),
+              vertical_align(relative_accuracy, max_buckets),
+              facial_activity(relative_accuracy, max_buckets),
+              face_movement(relative_accuracy, max_buckets)
+        {}
+
+        // Returns false when the sketches were built with different parameters
+        bool Merge(const SessionReport& other)
+        {
+            if (!horizontal_align.Merge(other.horizontal_align) ||
+                !vertical_align.Merge(other.vertical_align) ||
+                !facial_activity.Merge(other.facial_activity) ||
+                !face_movement.Merge(other.face_movement))
+            {
+                return false;
+            }
+            frames += other.frames;
+            left_eye_blinks += other.left_eye_blinks;
+            right_eye_blinks += other.right_eye_blinks;
+            for (int i = 0; i < ORIENTATION_STATE_COUNT; ++i)
+            {
+                horizontal_states[i] += other.horizontal_states[i];
+                vertical_states[i] += other.vertical_states[i];
+            }
+            return true;
+        }
+    };
+
+} // namespace mediapipe
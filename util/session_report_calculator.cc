@@ -0,0 +1,156 @@
+#include <memory>
+
+#include "absl/memory/memory.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/port/status.h"
+#include "mediapipe/calculators/custom/util/proctor_result.h"
+#include "mediapipe/calculators/custom/util/session_report.h"
+#include "mediapipe/calculators/custom/util/session_report_calculator.pb.h"
+#include "mediapipe/calculators/custom/util/calculator_trace.h"
+#include "mediapipe/calculators/custom/util/config_input.h"
+
+namespace mediapipe
+{
+
+    namespace
+    {
+        constexpr char kResultStreamTag[]   = "RESULT";
+        constexpr char kReportStreamTag[]   = "REPORT";
+        constexpr char kPreviousSideTag[]   = "PREVIOUS";
+
+        OrientationState Classify(double value, double negative, double positive)
+        {
+            return value >= positive ? ORIENTATION_POSITIVE:
+                   value <= negative ? ORIENTATION_NEGATIVE:
+                   ORIENTATION_NEUTRAL;
+        }
+    } // namespace
+
+    /**
+     * @brief Summarize a proctoring session in bounded memory
+     *
+     * Keeps a mergeable quantile sketch of every ProctorResult field plus blink
+     * and orientation-state counters, and emits the report in Close(), and
+     * optionally every `snapshot_interval` results. A report from an earlier
+     * graph run of the same session, e.g. before a reconnect, can be passed as
+     * PREVIOUS and is merged exactly.
+     *
+     * INPUTS:
+     *      RESULT - Proctor Result (ProctorResult)
+     *      CONFIG - (Optional) Replaces the orientation cut-offs from then on
+     *               (OrientationThresholds), see ConfigInput
+     * INPUT SIDE PACKETS:
+     *      PREVIOUS - (Optional) Report to continue from (SessionReport)
+     * OUTPUTS:
+     *      REPORT - Session Report (SessionReport)
+     *
+     * Example:
+     *
+     * node {
+     *   calculator: "SessionReportCalculator"
+     *   input_stream: "RESULT:proctor_result"
+     *   output_stream: "REPORT:session_report"
+     *   node_options: {
+     *     [type.googleapis.com/mediapipe.SessionReportCalculatorOptions] {
+     *       relative_accuracy: 0.01
+     *       snapshot_interval: 9000
+     *     }
+     *   }
+     * }
+     *
+     */
+    class SessionReportCalculator: public CalculatorBase
+    {
+    private:
+        SessionReportCalculatorOptions m_options;
+        ConfigInput<OrientationThresholds> m_thresholds;
+        std::unique_ptr<SessionReport> m_report;
+        bool m_was_left_blinking = false;
+        bool m_was_right_blinking = false;
+        Timestamp m_last_timestamp = Timestamp::Unset();
+
+    public:
+        SessionReportCalculator() = default;
+        ~SessionReportCalculator() override = default;
+
+        static absl::Status GetContract(CalculatorContract* cc);
+
+        absl::Status Open(CalculatorContext* cc) override;
+        absl::Status Process(CalculatorContext* cc) override;
+        absl::Status Close(CalculatorContext* cc) override;
+    };
+
+    // Register the calculator to be used in the graph
+    REGISTER_CALCULATOR(SessionReportCalculator);
+
+    absl::Status SessionReportCalculator::GetContract(CalculatorContract* cc)
+    {
+        cc->Inputs().Tag(kResultStreamTag).Set<ProctorResult>();
+        if (cc->InputSidePackets().HasTag(kPreviousSideTag))
+        {
+            cc->InputSidePackets().Tag(kPreviousSideTag).Set<SessionReport>();
+        }
+        cc->Outputs().Tag(kReportStreamTag).Set<SessionReport>();
+        ConfigInput<OrientationThresholds>::SetContract(cc);
+        return absl::OkStatus();
+    }
+
+    absl::Status SessionReportCalculator::Open(CalculatorContext* cc)
+    {
+        m_options = cc->Options<SessionReportCalculatorOptions>();
+        m_thresholds.Open(m_options.thresholds());
+        m_report = absl::make_unique<SessionReport>(m_options.relative_accuracy(), m_options.max_buckets());
+        if (cc->InputSidePackets().HasTag(kPreviousSideTag))
+        {
+            if (!m_report->Merge(cc->InputSidePackets().Tag(kPreviousSideTag).Get<SessionReport>()))
+            {
+                return absl::InvalidArgumentError("PREVIOUS report was built with a different relative_accuracy");
+            }
+        }
+        return absl::OkStatus();
+    }
+
+    absl::Status SessionReportCalculator::Process(CalculatorContext* cc)
+    {
+        CALCULATOR_TRACE_SCOPE("SessionReportCalculator", cc);
+        m_thresholds.Update(cc);
+        if (cc->Inputs().Tag(kResultStreamTag).IsEmpty()) { return absl::OkStatus(); }
+
+        const auto& result = cc->Inputs().Tag(kResultStreamTag).Get<ProctorResult>();
+        const auto& thresholds = m_thresholds.Get();
+
+        m_report->horizontal_align.Add(result.horizontal_align);
+        m_report->vertical_align.Add(result.vertical_align);
+        m_report->facial_activity.Add(result.facial_activity);
+        m_report->face_movement.Add(result.face_movement);
+        ++m_report->frames;
+
+        m_report->left_eye_blinks += result.is_left_eye_blinking && !m_was_left_blinking;
+        m_report->right_eye_blinks += result.is_right_eye_blinking && !m_was_right_blinking;
+        m_was_left_blinking = result.is_left_eye_blinking;
+        m_was_right_blinking = result.is_right_eye_blinking;
+
+        ++m_report->horizontal_states[Classify(result.horizontal_align, thresholds.left(), thresholds.right())];
+        ++m_report->vertical_states[Classify(result.vertical_align, thresholds.up(), thresholds.down())];
+
+        m_last_timestamp = cc->InputTimestamp();
+        if (m_options.snapshot_interval() > 0 && m_report->frames % m_options.snapshot_interval() == 0)
+        {
+            cc->Outputs().Tag(kReportStreamTag).AddPacket(
+                MakePacket<SessionReport>(*m_report).At(cc->InputTimestamp())
+            );
+        }
+
+        return absl::OkStatus();
+    } // Process()
+
+    absl::Status SessionReportCalculator::Close(CalculatorContext* cc)
+    {
+        const Timestamp timestamp = m_last_timestamp == Timestamp::Unset() ?
+            Timestamp::PostStream():
+            m_last_timestamp.NextAllowedInStream();
+        cc->Outputs().Tag(kReportStreamTag).Add(m_report.release(), timestamp);
+        return absl::OkStatus();
+    }
+
+} // namespace mediapipe
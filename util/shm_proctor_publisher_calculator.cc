@@ -0,0 +1,145 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+
+#include "absl/strings/str_cat.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/port/status.h"
+#include "mediapipe/framework/formats/landmark.pb.h"
+#include "mediapipe/calculators/custom/util/proctor_result.h"
+#include "mediapipe/calculators/custom/util/shm_proctor_ring.h"
+#include "mediapipe/calculators/custom/util/shm_proctor_publisher_calculator.pb.h"
+#include "mediapipe/calculators/custom/util/allocation_profiler.h"
+#include "mediapipe/calculators/custom/util/calculator_trace.h"
+
+namespace mediapipe
+{
+
+    namespace
+    {
+        constexpr char kResultStreamTag[]    = "RESULT";
+        constexpr char kLandmarksStreamTag[] = "LANDMARKS";
+    } // namespace
+
+    /**
+     * @brief Publish Proctor Results and landmarks to other local processes
+     *
+     * Writes each result, and the landmarks of the same timestamp when given,
+     * into a ShmProctorRing shared-memory segment. Other processes attach with
+     * ShmProctorRing::Attach() and read frames in place, so nothing is
+     * serialized and the graph never waits on them.
+     *
+     * INPUTS:
+     *      RESULT - Proctor Result (ProctorResult)
+     *      LANDMARKS - (Optional) Landmarks (NormalizedLandmarkList)
+     *
+     * Example:
+     *
+     * node {
+     *   calculator: "ShmProctorPublisherCalculator"
+     *   input_stream: "RESULT:proctor_result"
+     *   input_stream: "LANDMARKS:face_landmarks"
+     *   node_options: {
+     *     [type.googleapis.com/mediapipe.ShmProctorPublisherCalculatorOptions] {
+     *       name: "/proctor_session"
+     *     }
+     *   }
+     * }
+     *
+     * Reader process:
+     *
+     *   auto ring = ShmProctorRing::Attach("/proctor_session");
+     *   ShmProctorRing::Frame frame;
+     *   if (ring->PeekLatest(&frame)) {
+     *     ... use frame.result, frame.landmarks ...
+     *     if (!ring->Validate(frame)) { ... overwritten, discard ... }
+     *   }
+     *
+     */
+    class ShmProctorPublisherCalculator: public CalculatorBase
+    {
+    private:
+        std::unique_ptr<ShmProctorRing> m_ring;
+
+    public:
+        ShmProctorPublisherCalculator() = default;
+        ~ShmProctorPublisherCalculator() override = default;
+
+        static absl::Status GetContract(CalculatorContract* cc);
+
+        absl::Status Open(CalculatorContext* cc) override;
+        absl::Status Process(CalculatorContext* cc) override;
+        absl::Status Close(CalculatorContext* cc) override;
+    };
+
+    // Register the calculator to be used in the graph
+    REGISTER_CALCULATOR(ShmProctorPublisherCalculator);
+    // Publishing writes into preallocated slots only
+    REGISTER_ALLOCATION_FREE_CALCULATOR(ShmProctorPublisherCalculator);
+
+    absl::Status ShmProctorPublisherCalculator::GetContract(CalculatorContract* cc)
+    {
+        cc->Inputs().Tag(kResultStreamTag).Set<ProctorResult>();
+        if (cc->Inputs().HasTag(kLandmarksStreamTag))
+        {
+            cc->Inputs().Tag(kLandmarksStreamTag).Set<NormalizedLandmarkList>();
+        }
+        return absl::OkStatus();
+    }
+
+    absl::Status ShmProctorPublisherCalculator::Open(CalculatorContext* cc)
+    {
+        const auto& options = cc->Options<ShmProctorPublisherCalculatorOptions>();
+        if (options.slots() <= 0 || options.max_landmarks() < 0)
+        {
+            return absl::InvalidArgumentError("ShmProctorPublisherCalculator needs positive slots");
+        }
+
+        m_ring = ShmProctorRing::Create(
+            options.name(), options.slots(), options.max_landmarks(), options.unlink_on_close(),
+            static_cast<mode_t>(options.mode() & 0777)
+        );
+        if (!m_ring)
+        {
+            return absl::UnavailableError(absl::StrCat(
+                "Failed to create shared memory ring ", options.name(), ": ", std::strerror(errno)
+            ));
+        }
+        return absl::OkStatus();
+    }
+
+    absl::Status ShmProctorPublisherCalculator::Process(CalculatorContext* cc)
+    {
+        CALCULATOR_TRACE_SCOPE("ShmProctorPublisherCalculator", cc);
+        if (cc->Inputs().Tag(kResultStreamTag).IsEmpty()) { return absl::OkStatus(); }
+
+        const auto& result = cc->Inputs().Tag(kResultStreamTag).Get<ProctorResult>();
+        float* xyz = m_ring->BeginPublish(cc->InputTimestamp().Microseconds(), result);
+
+        int num_landmarks = 0;
+        if (cc->Inputs().HasTag(kLandmarksStreamTag) && !cc->Inputs().Tag(kLandmarksStreamTag).IsEmpty())
+        {
+            const auto& landmarks = cc->Inputs().Tag(kLandmarksStreamTag).Get<NormalizedLandmarkList>();
+            num_landmarks = std::min<int>(landmarks.landmark_size(), m_ring->MaxLandmarks());
+            for (int i = 0; i < num_landmarks; ++i, xyz += 3)
+            {
+                const auto& landmark = landmarks.landmark(i);
+                xyz[0] = landmark.x();
+                xyz[1] = landmark.y();
+                xyz[2] = landmark.z();
+            }
+        }
+        m_ring->EndPublish(num_landmarks);
+
+        return absl::OkStatus();
+    } // Process()
+
+    absl::Status ShmProctorPublisherCalculator::Close(CalculatorContext* cc)
+    {
+        // Marks the segment closed so readers can reattach on the next run
+        m_ring.reset();
+        return absl::OkStatus();
+    }
+
+} // namespace mediapipe
@@ -0,0 +1,206 @@
+#include "mediapipe/calculators/custom/util/shm_proctor_ring.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace mediapipe
+{
+
+    namespace
+    {
+        uint32_t RoundUpToPowerOfTwo(uint32_t value)
+        {
+            uint32_t result = 2;
+            while (result < value) { result <<= 1; }
+            return result;
+        }
+
+        uint64_t SlotSize(uint32_t max_landmarks)
+        {
+            const uint64_t size = sizeof(ShmProctorRing::Slot) + uint64_t(max_landmarks) * 3 * sizeof(float);
+            return (size + alignof(ShmProctorRing::Slot) - 1) / alignof(ShmProctorRing::Slot) * alignof(ShmProctorRing::Slot);
+        }
+    } // namespace
+
+    ShmProctorRing::ShmProctorRing(std::string name, bool is_writer)
+        : m_name(std::move(name)), m_is_writer(is_writer)
+    {}
+
+    ShmProctorRing::~ShmProctorRing()
+    {
+        if (m_header && m_is_writer) { m_header->closed.store(1, std::memory_order_release); }
+        if (m_mapping) { munmap(m_mapping, m_mapping_size); }
+        if (m_is_writer && m_unlink_on_close) { shm_unlink(m_name.c_str()); }
+    }
+
+    std::unique_ptr<ShmProctorRing> ShmProctorRing::Create(
+        const std::string& name, uint32_t slot_count, uint32_t max_landmarks, bool unlink_on_close, mode_t mode
+    )
+    {
+        slot_count = RoundUpToPowerOfTwo(slot_count);
+        const uint64_t slot_size = SlotSize(max_landmarks);
+        const size_t size = sizeof(Header) + slot_count * slot_size;
+
+        // A fresh segment, readers of a previous run keep their old mapping
+        // and see it closed
+        shm_unlink(name.c_str());
+        int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, mode);
+        if (fd < 0) { return nullptr; }
+        // Exactly `mode`, whatever the umask
+        if (fchmod(fd, mode) != 0 || ftruncate(fd, size) != 0)
+        {
+            const int error = errno;
+            close(fd);
+            shm_unlink(name.c_str());
+            errno = error;
+            return nullptr;
+        }
+        void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (mapping == MAP_FAILED)
+        {
+            const int error = errno;
+            shm_unlink(name.c_str());
+            errno = error;
+            return nullptr;
+        }
+
+        std::unique_ptr<ShmProctorRing> ring(new ShmProctorRing(name, true));
+        ring->m_unlink_on_close = unlink_on_close;
+        ring->m_mapping = mapping;
+        ring->m_mapping_size = size;
+        ring->m_mask = slot_count - 1;
+        ring->m_slot_size = slot_size;
+        ring->m_max_landmarks = max_landmarks;
+
+        // ftruncate zero-fills, so every slot version starts at 0
+        Header* header = new (mapping) Header;
+        header->version = kVersion;
+        header->slot_count = slot_count;
+        header->max_landmarks = max_landmarks;
+        header->slot_size = slot_size;
+        header->result_size = sizeof(ProctorResult);
+        header->closed.store(0, std::memory_order_relaxed);
+        header->head.store(0, std::memory_order_relaxed);
+        for (uint32_t i = 0; i < slot_count; ++i)
+        {
+            new (static_cast<char*>(mapping) + sizeof(Header) + i * slot_size) Slot();
+        }
+        // Readers check the magic last written
+        std::atomic_thread_fence(std::memory_order_release);
+        header->magic = kMagic;
+        ring->m_header = header;
+        return ring;
+    } // Create()
+
+    std::unique_ptr<ShmProctorRing> ShmProctorRing::Attach(const std::string& name)
+    {
+        int fd = shm_open(name.c_str(), O_RDONLY, 0);
+        if (fd < 0) { return nullptr; }
+        struct stat info;
+        if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(Header))
+        {
+            close(fd);
+            errno = EPROTO;
+            return nullptr;
+        }
+        const size_t size = info.st_size;
+        void* mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (mapping == MAP_FAILED) { return nullptr; }
+
+        const Header* header = static_cast<const Header*>(mapping);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (header->magic != kMagic || header->version != kVersion || header->result_size != sizeof(ProctorResult) ||
+            header->slot_count == 0 || (header->slot_count & (header->slot_count - 1)) != 0 ||
+            header->slot_size != SlotSize(header->max_landmarks) ||
+            sizeof(Header) + header->slot_count * header->slot_size > size)
+        {
+            munmap(mapping, size);
+            errno = EPROTO;
+            return nullptr;
+        }
+
+        std::unique_ptr<ShmProctorRing> ring(new ShmProctorRing(name, false));
+        ring->m_mapping = mapping;
+        ring->m_mapping_size = size;
+        ring->m_header = const_cast<Header*>(header);
+        ring->m_mask = header->slot_count - 1;
+        ring->m_slot_size = header->slot_size;
+        ring->m_max_landmarks = header->max_landmarks;
+        return ring;
+    } // Attach()
+
+    ShmProctorRing::Slot* ShmProctorRing::SlotAt(uint64_t sequence) const
+    {
+        return reinterpret_cast<Slot*>(
+            static_cast<char*>(m_mapping) + sizeof(Header) + (sequence & m_mask) * m_slot_size
+        );
+    }
+
+    float* ShmProctorRing::BeginPublish(int64_t timestamp_us, const ProctorResult& result)
+    {
+        const uint64_t sequence = m_header->head.load(std::memory_order_relaxed) + 1;
+        Slot* slot = this->SlotAt(sequence);
+
+        slot->version.store(2 * sequence - 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot->timestamp_us = timestamp_us;
+        slot->result = result;
+        return LandmarksOf(slot);
+    } // BeginPublish()
+
+    void ShmProctorRing::EndPublish(uint32_t num_landmarks)
+    {
+        const uint64_t sequence = m_header->head.load(std::memory_order_relaxed) + 1;
+        Slot* slot = this->SlotAt(sequence);
+
+        slot->num_landmarks = std::min(num_landmarks, m_max_landmarks);
+        slot->version.store(2 * sequence, std::memory_order_release);
+        m_header->head.store(sequence, std::memory_order_release);
+    } // EndPublish()
+
+    bool ShmProctorRing::Peek(uint64_t sequence, Frame* frame) const
+    {
+        if (sequence == 0) { return false; }
+        Slot* slot = this->SlotAt(sequence);
+        if (slot->version.load(std::memory_order_acquire) != 2 * sequence) { return false; }
+
+        frame->sequence = sequence;
+        frame->timestamp_us = slot->timestamp_us;
+        frame->result = &slot->result;
+        frame->num_landmarks = std::min(slot->num_landmarks, m_max_landmarks);
+        frame->landmarks = LandmarksOf(slot);
+        return true;
+    } // Peek()
+
+    bool ShmProctorRing::Validate(const Frame& frame) const
+    {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return this->SlotAt(frame.sequence)->version.load(std::memory_order_relaxed) == 2 * frame.sequence;
+    } // Validate()
+
+    bool ShmProctorRing::Read(
+        uint64_t sequence, ProctorResult* result, int64_t* timestamp_us,
+        float* landmarks, uint32_t landmark_capacity, uint32_t* num_landmarks
+    ) const
+    {
+        Frame frame;
+        if (!this->Peek(sequence, &frame)) { return false; }
+
+        *result = *frame.result;
+        *timestamp_us = frame.timestamp_us;
+        const uint32_t count = std::min(frame.num_landmarks, landmark_capacity);
+        if (landmarks && count) { std::memcpy(landmarks, frame.landmarks, count * 3 * sizeof(float)); }
+        if (num_landmarks) { *num_landmarks = count; }
+        return this->Validate(frame);
+    } // Read()
+
+} // namespace mediapipe
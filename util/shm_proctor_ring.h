@@ -0,0 +1,142 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <sys/types.h>
+
+#include "mediapipe/calculators/custom/util/proctor_result.h"
+
+namespace mediapipe
+{
+
+    /**
+     * @brief Proctor Results and landmarks shared with other local processes
+     *
+     * A POSIX shared-memory segment holding a header followed by a
+     * power-of-two number of fixed-size slots. Each slot is a seqlock: the
+     * writer bumps its version to odd, writes the result and up to
+     * `max_landmarks` xyz triplets, then bumps it back to even. Readers never
+     * write to the segment, so any number of processes can map it read-only.
+     *
+     * Readers either copy a frame with Read()/ReadLatest(), or use Peek() to get
+     * pointers straight into the segment and call Validate() once done with
+     * them; a failed Validate() means the writer lapped the ring meanwhile and
+     * the data must be discarded. Neither path makes a syscall.
+     *
+     * Sequences start at 1; 0 means nothing has been published yet. The
+     * layout is host-endian and assumes both sides share the ProctorResult ABI,
+     * which kVersion guards.
+     */
+    class ShmProctorRing
+    {
+    public:
+        static constexpr uint32_t kMagic = 0x50524f43;  // "PROC"
+        static constexpr uint32_t kVersion = 1;
+
+        struct alignas(64) Header
+        {
+            uint32_t magic;
+            uint32_t version;
+            uint32_t slot_count;
+            uint32_t max_landmarks;
+            uint64_t slot_size;
+            uint32_t result_size;
+            // Set by the writer when it goes away; readers should reattach
+            std::atomic<uint32_t> closed;
+            alignas(64) std::atomic<uint64_t> head;
+        };
+
+        struct alignas(64) Slot
+        {
+            // 2 * sequence when complete, 2 * sequence - 1 while being written
+            std::atomic<uint64_t> version;
+            int64_t timestamp_us;
+            ProctorResult result;
+            uint32_t num_landmarks;
+            // Followed by max_landmarks * 3 floats
+        };
+
+        // Points into the segment, only valid until Validate() fails
+        struct Frame
+        {
+            uint64_t sequence = 0;
+            int64_t timestamp_us = 0;
+            const ProctorResult* result = nullptr;
+            uint32_t num_landmarks = 0;
+            const float* landmarks = nullptr;
+        };
+
+    private:
+        std::string m_name;
+        bool m_is_writer;
+        bool m_unlink_on_close = false;
+        void* m_mapping = nullptr;
+        size_t m_mapping_size = 0;
+        Header* m_header = nullptr;
+        // Layout validated at Create()/Attach(); the shared header is never
+        // trusted again, so a misbehaving writer cannot push reads out of bounds
+        uint64_t m_mask = 0;
+        uint64_t m_slot_size = 0;
+        uint32_t m_max_landmarks = 0;
+
+        ShmProctorRing(std::string name, bool is_writer);
+
+        Slot* SlotAt(uint64_t sequence) const;
+        static float* LandmarksOf(Slot* slot) { return reinterpret_cast<float*>(slot + 1); }
+
+    public:
+        ~ShmProctorRing();
+
+        ShmProctorRing(const ShmProctorRing&) = delete;
+        ShmProctorRing& operator=(const ShmProctorRing&) = delete;
+
+        // Creates (replacing any stale segment) and maps `name` for writing.
+        // The default mode keeps the landmarks private to the writer's user.
+        // Returns nullptr with errno set on failure.
+        static std::unique_ptr<ShmProctorRing> Create(
+            const std::string& name, uint32_t slot_count, uint32_t max_landmarks, bool unlink_on_close = true,
+            mode_t mode = 0600
+        );
+
+        // Maps an existing segment read-only. Returns nullptr with errno set
+        // on failure, EPROTO when the layout does not match.
+        static std::unique_ptr<ShmProctorRing> Attach(const std::string& name);
+
+        uint32_t SlotCount() const { return static_cast<uint32_t>(m_mask + 1); }
+        uint32_t MaxLandmarks() const { return m_max_landmarks; }
+        bool IsClosed() const { return m_header->closed.load(std::memory_order_acquire) != 0; }
+
+        // Writer side: BeginPublish() returns the slot's landmark buffer to be
+        // filled with up to MaxLandmarks() xyz triplets before EndPublish()
+        float* BeginPublish(int64_t timestamp_us, const ProctorResult& result);
+        void EndPublish(uint32_t num_landmarks);
+
+        uint64_t LatestSequence() const { return m_header->head.load(std::memory_order_acquire); }
+
+        // Zero-copy access
+        bool Peek(uint64_t sequence, Frame* frame) const;
+        bool PeekLatest(Frame* frame) const { return this->Peek(this->LatestSequence(), frame); }
+        bool Validate(const Frame& frame) const;
+
+        // Copies a frame; `landmarks` receives up to `landmark_capacity` xyz triplets
+        bool Read(
+            uint64_t sequence, ProctorResult* result, int64_t* timestamp_us,
+            float* landmarks = nullptr, uint32_t landmark_capacity = 0, uint32_t* num_landmarks = nullptr
+        ) const;
+        bool ReadLatest(
+            ProctorResult* result, int64_t* timestamp_us,
+            float* landmarks = nullptr, uint32_t landmark_capacity = 0, uint32_t* num_landmarks = nullptr
+        ) const
+        {
+            return this->Read(this->LatestSequence(), result, timestamp_us, landmarks, landmark_capacity, num_landmarks);
+        }
+    };
+
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared-memory seqlock needs lock-free 64-bit atomics");
+    static_assert(std::atomic<uint32_t>::is_always_lock_free, "shared-memory seqlock needs lock-free 32-bit atomics");
+
+} // namespace mediapipe
@@ -0,0 +1,104 @@
+#include <string>
+#include <vector>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "absl/strings/str_cat.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/calculators/custom/util/shm_proctor_ring.h"
+
+namespace mediapipe
+{
+
+    namespace
+    {
+        std::string UniqueName(const std::string& test)
+        {
+            return absl::StrCat("/shm_proctor_ring_test_", test, "_", getpid());
+        }
+
+        void Publish(ShmProctorRing& ring, int64_t timestamp_us, float value, uint32_t num_landmarks)
+        {
+            ProctorResult result {};
+            result.horizontal_align = value;
+            float* xyz = ring.BeginPublish(timestamp_us, result);
+            for (uint32_t i = 0; i < 3 * num_landmarks; ++i) { xyz[i] = value + i; }
+            ring.EndPublish(num_landmarks);
+        }
+    } // namespace
+
+    TEST(ShmProctorRingTest, AttachedReaderPeeksPublishedFrames)
+    {
+        const std::string name = UniqueName("peek");
+        auto writer = ShmProctorRing::Create(name, 4, 8);
+        ASSERT_NE(writer, nullptr);
+        auto reader = ShmProctorRing::Attach(name);
+        ASSERT_NE(reader, nullptr);
+        EXPECT_EQ(reader->SlotCount(), 4);
+        EXPECT_EQ(reader->MaxLandmarks(), 8);
+
+        ShmProctorRing::Frame frame;
+        EXPECT_FALSE(reader->PeekLatest(&frame));
+
+        Publish(*writer, 1000, 0.5f, 3);
+        ASSERT_TRUE(reader->PeekLatest(&frame));
+        EXPECT_EQ(frame.sequence, 1);
+        EXPECT_EQ(frame.timestamp_us, 1000);
+        EXPECT_FLOAT_EQ(frame.result->horizontal_align, 0.5f);
+        ASSERT_EQ(frame.num_landmarks, 3);
+        EXPECT_FLOAT_EQ(frame.landmarks[8], 8.5f);
+        EXPECT_TRUE(reader->Validate(frame));
+
+        // Lapping the ring invalidates the peeked frame
+        for (int i = 2; i <= 5; ++i) { Publish(*writer, i * 1000, i, 2); }
+        EXPECT_FALSE(reader->Validate(frame));
+
+        ProctorResult result;
+        int64_t timestamp_us;
+        std::vector<float> landmarks(3 * 8);
+        uint32_t num_landmarks = 0;
+        ASSERT_TRUE(reader->ReadLatest(&result, &timestamp_us, landmarks.data(), 8, &num_landmarks));
+        EXPECT_EQ(timestamp_us, 5000);
+        EXPECT_EQ(num_landmarks, 2);
+        EXPECT_FLOAT_EQ(landmarks[5], 10.0f);
+        // Overwritten sequences are gone
+        EXPECT_FALSE(reader->Read(1, &result, &timestamp_us));
+
+        EXPECT_FALSE(reader->IsClosed());
+        writer.reset();
+        EXPECT_TRUE(reader->IsClosed());
+    }
+
+    TEST(ShmProctorRingTest, ExtraLandmarksAreClampedToCapacity)
+    {
+        const std::string name = UniqueName("clamp");
+        auto writer = ShmProctorRing::Create(name, 2, 4);
+        ASSERT_NE(writer, nullptr);
+        auto reader = ShmProctorRing::Attach(name);
+        ASSERT_NE(reader, nullptr);
+
+        ProctorResult result {};
+        writer->BeginPublish(1, result);
+        writer->EndPublish(100);
+        ShmProctorRing::Frame frame;
+        ASSERT_TRUE(reader->PeekLatest(&frame));
+        EXPECT_EQ(frame.num_landmarks, 4);
+    }
+
+    TEST(ShmProctorRingTest, SegmentIsPrivateByDefault)
+    {
+        const std::string name = UniqueName("mode");
+        auto writer = ShmProctorRing::Create(name, 2, 1);
+        ASSERT_NE(writer, nullptr);
+        struct stat info;
+        ASSERT_EQ(stat(absl::StrCat("/dev/shm", name).c_str(), &info), 0);
+        EXPECT_EQ(info.st_mode & 0777, 0600);
+    }
+
+    TEST(ShmProctorRingTest, AttachFailsWithoutWriter)
+    {
+        EXPECT_EQ(ShmProctorRing::Attach(UniqueName("missing")), nullptr);
+    }
+
+} // namespace mediapipe
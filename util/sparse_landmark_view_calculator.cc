@@ -0,0 +1,183 @@
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/port/status.h"
+#include "mediapipe/framework/formats/landmark.pb.h"
+#include "mediapipe/calculators/custom/util/sparse_landmarks.h"
+#include "mediapipe/calculators/custom/util/sparse_landmark_view_calculator.pb.h"
+#include "mediapipe/calculators/custom/util/landmark_tensor.h"
+#include "mediapipe/calculators/custom/util/calculator_trace.h"
+#include "mediapipe/calculators/custom/util/stateless_calculator.h"
+
+namespace mediapipe
+{
+
+    /**
+     * @brief Keep only the landmarks downstream calculators read
+     *
+     * Emits the union of the indices declared by the `consumer` calculators,
+     * plus any extra `index`, with the whole-mesh mean and standard deviation,
+     * so EyeBlinkCalculator, FaceOrientationCalculator and
+     * FaceMovementCalculator can run from a few dozen bytes instead of the
+     * raw and standardized copies of the full mesh.
+     *
+     * INPUTS:
+     *      0 - Landmarks (NormalizedLandmarkList)
+     *      TENSORS - Alternative to 0, face mesh model output read in place
+     *                (std::vector<Tensor>), see LandmarkTensorReader
+     * OUTPUTS:
+     *      0 - Landmark subset (SparseLandmarks)
+     *
+     * Example:
+     *
+     * node {
+     *   calculator: "SparseLandmarkViewCalculator"
+     *   input_stream: "face_landmarks"
+     *   output_stream: "face_sparse_landmarks"
+     *   node_options: {
+     *     [type.googleapis.com/mediapipe.SparseLandmarkViewCalculatorOptions] {
+     *       consumer: "EyeBlinkCalculator"
+     *       consumer: "FaceOrientationCalculator"
+     *       consumer: "FaceMovementCalculator"
+     *     }
+     *   }
+     * }
+     *
+     * node {
+     *   calculator: "EyeBlinkCalculator"
+     *   input_stream: "SPARSE:face_sparse_landmarks"
+     *   output_stream: "face_blinks"
+     * }
+     *
+     */
+    class SparseLandmarkViewCalculator: public CalculatorBase
+    {
+    private:
+        std::vector<int> m_indices;
+        // Slot of each mesh index in the output, -1 when dropped
+        std::vector<int> m_slot_of;
+        LandmarkTensorReader m_tensor_reader;
+
+    public:
+        SparseLandmarkViewCalculator() = default;
+        ~SparseLandmarkViewCalculator() override = default;
+
+        static absl::Status GetContract(CalculatorContract* cc);
+
+        absl::Status Open(CalculatorContext* cc) override;
+        absl::Status Process(CalculatorContext* cc) override;
+        absl::Status Close(CalculatorContext* cc) override;
+    };
+
+    // Register the calculator to be used in the graph
+    REGISTER_CALCULATOR(SparseLandmarkViewCalculator);
+    REGISTER_STATELESS_CALCULATOR(SparseLandmarkViewCalculator);
+
+    absl::Status SparseLandmarkViewCalculator::GetContract(CalculatorContract* cc)
+    {
+        if (LandmarkTensorReader::HasInput(cc))
+        {
+            LandmarkTensorReader::SetContract(cc);
+        }else
+        {
+            cc->Inputs().Index(0).Set<NormalizedLandmarkList>();
+        }
+        cc->Outputs().Index(0).Set<SparseLandmarks>();
+        return absl::OkStatus();
+    }
+
+    absl::Status SparseLandmarkViewCalculator::Open(CalculatorContext* cc)
+    {
+        const auto& options = cc->Options<SparseLandmarkViewCalculatorOptions>();
+        m_indices.assign(options.index().begin(), options.index().end());
+        for (const auto& consumer: options.consumer())
+        {
+            std::vector<int> indices;
+            if (!SparseLandmarkIndexRegistry::Lookup(consumer, &indices))
+            {
+                return absl::NotFoundError(absl::StrCat(consumer, " does not declare sparse landmark indices"));
+            }
+            m_indices.insert(m_indices.end(), indices.begin(), indices.end());
+        }
+        std::sort(m_indices.begin(), m_indices.end());
+        m_indices.erase(std::unique(m_indices.begin(), m_indices.end()), m_indices.end());
+        if (m_indices.empty())
+        {
+            return absl::InvalidArgumentError("SparseLandmarkViewCalculator needs a consumer or an index");
+        }
+        if (m_indices.front() < 0) { return absl::InvalidArgumentError("Negative landmark index"); }
+
+        m_slot_of.assign(m_indices.back() + 1, -1);
+        for (size_t slot = 0; slot < m_indices.size(); ++slot) { m_slot_of[m_indices[slot]] = slot; }
+
+        m_tensor_reader.Open(cc);
+        cc->SetOffset(TimestampDiff(0));
+        return absl::OkStatus();
+    }
+
+    absl::Status SparseLandmarkViewCalculator::Process(CalculatorContext* cc)
+    {
+        CALCULATOR_TRACE_SCOPE("SparseLandmarkViewCalculator", cc);
+        const bool from_tensor = cc->Inputs().HasTag(LandmarkTensorReader::kTensorsTag);
+        const int num_landmarks = from_tensor ?
+            m_tensor_reader.NumLandmarks(cc):
+            cc->Inputs().Index(0).Get<NormalizedLandmarkList>().landmark_size();
+        if (num_landmarks <= m_indices.back())
+        {
+            return absl::InvalidArgumentError(absl::StrCat(
+                "Mesh of ", num_landmarks, " landmarks lacks index ", m_indices.back()));
+        }
+
+        auto sparse = absl::make_unique<SparseLandmarks>();
+        sparse->indices = m_indices;
+        sparse->xyz.resize(3 * m_indices.size());
+        sparse->mesh_size = num_landmarks;
+
+        // Single pass gathering the kept points and the whole-mesh moments
+        std::array<double, 3> sum {}, sum_sq {};
+        float* xyz = sparse->xyz.data();
+        const int num_slots = m_slot_of.size();
+        auto gather = [&](int i, float x, float y, float z) {
+            const float point[3] = { x, y, z };
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                sum[axis] += point[axis];
+                sum_sq[axis] += static_cast<double>(point[axis]) * point[axis];
+            }
+            const int slot = i < num_slots ? m_slot_of[i]: -1;
+            if (slot >= 0) { std::copy(point, point + 3, xyz + 3 * slot); }
+        };
+        if (from_tensor)
+        {
+            MP_RETURN_IF_ERROR(m_tensor_reader.ForEach(cc, gather));
+        }else
+        {
+            const auto& landmarks = cc->Inputs().Index(0).Get<NormalizedLandmarkList>();
+            for (int i = 0; i < num_landmarks; ++i)
+            {
+                const auto& landmark = landmarks.landmark(i);
+                gather(i, landmark.x(), landmark.y(), landmark.z());
+            }
+        }
+
+        // Population statistics, as cv::meanStdDev
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            const double mean = sum[axis] / num_landmarks;
+            sparse->mean[axis] = mean;
+            sparse->std_dev[axis] = std::sqrt(std::max(0.0, sum_sq[axis] / num_landmarks - mean * mean));
+        }
+
+        cc->Outputs().Index(0).Add(sparse.release(), cc->InputTimestamp());
+
+        return absl::OkStatus();
+    } // Process()
+
+    absl::Status SparseLandmarkViewCalculator::Close(CalculatorContext* cc)
+    { return absl::OkStatus(); }
+
+} // namespace mediapipe
@@ -0,0 +1,39 @@
+#include "mediapipe/calculators/custom/util/sparse_landmarks.h"
+
+#include <map>
+#include <mutex>
+
+namespace mediapipe
+{
+
+    namespace
+    {
+        std::mutex& RegistryMutex()
+        {
+            static std::mutex* mutex = new std::mutex;
+            return *mutex;
+        }
+
+        std::map<std::string, std::vector<int>>& Registry()
+        {
+            static auto* registry = new std::map<std::string, std::vector<int>>;
+            return *registry;
+        }
+    } // namespace
+
+    bool SparseLandmarkIndexRegistry::Register(const std::string& name, std::vector<int> indices)
+    {
+        std::lock_guard<std::mutex> lock(RegistryMutex());
+        return Registry().emplace(name, std::move(indices)).second;
+    }
+
+    bool SparseLandmarkIndexRegistry::Lookup(const std::string& name, std::vector<int>* indices)
+    {
+        std::lock_guard<std::mutex> lock(RegistryMutex());
+        auto it = Registry().find(name);
+        if (it == Registry().end()) { return false; }
+        *indices = it->second;
+        return true;
+    }
+
+} // namespace mediapipe
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace mediapipe
+{
+
+    /**
+     * @brief Subset of a face mesh with the whole-mesh statistics
+     *
+     * Carries only the landmarks downstream calculators read, as packed xyz
+     * triplets in mesh coordinates, with the per-axis mean and population
+     * standard deviation of the full mesh, so consumers of standardized
+     * landmarks get the same values LandmarkStandardizationCalculator gives.
+     */
+    struct SparseLandmarks
+    {
+        // Face mesh index of each kept landmark, ascending
+        std::vector<int> indices;
+        // Kept landmarks as packed xyz triplets, in the order of `indices`
+        std::vector<float> xyz;
+        // Per-axis statistics of the whole mesh, as cv::meanStdDev computes them
+        std::array<double, 3> mean {};
+        std::array<double, 3> std_dev {};
+        // Number of landmarks in the source mesh
+        int mesh_size = 0;
+
+        // Slot of a mesh index, -1 when the landmark was not kept
+        int Find(int mesh_index) const
+        {
+            auto it = std::lower_bound(indices.begin(), indices.end(), mesh_index);
+            if (it == indices.end() || *it != mesh_index) { return -1; }
+            return static_cast<int>(it - indices.begin());
+        }
+
+        bool Has(int mesh_index) const { return this->Find(mesh_index) >= 0; }
+
+        template <typename Indices>
+        bool HasAll(const Indices& mesh_indices) const
+        {
+            return std::all_of(std::begin(mesh_indices), std::end(mesh_indices),
+                               [this](int mesh_index) { return this->Has(mesh_index); });
+        }
+
+        // Mesh coordinates of a kept landmark
+        std::array<double, 3> Raw(int mesh_index) const
+        {
+            const float* point = xyz.data() + 3 * this->Find(mesh_index);
+            return { point[0], point[1], point[2] };
+        }
+
+        // Standardized coordinates of a kept landmark
+        std::array<double, 3> Standardized(int mesh_index) const
+        {
+            std::array<double, 3> point = this->Raw(mesh_index);
+            for (int axis = 0; axis < 3; ++axis) { point[axis] = (point[axis] - mean[axis]) / std_dev[axis]; }
+            return point;
+        }
+    };
+
+    /**
+     * @brief Registry of the mesh indices each calculator reads
+     *
+     * Calculators accepting SparseLandmarks declare the landmarks they need;
+     * SparseLandmarkViewCalculator keeps the union over its consumers.
+     */
+    class SparseLandmarkIndexRegistry
+    {
+    public:
+        static bool Register(const std::string& name, std::vector<int> indices);
+        // False when no calculator of that name declared its indices
+        static bool Lookup(const std::string& name, std::vector<int>* indices);
+    };
+
+} // namespace mediapipe
+
+// Declares the mesh indices (an array) a calculator reads; place next to REGISTER_CALCULATOR
+#define REGISTER_SPARSE_LANDMARK_INDICES(name, indices)                  \
+    static const bool sparse_landmark_indices_registered_##name =        \
+        ::mediapipe::SparseLandmarkIndexRegistry::Register(              \
+            #name, std::vector<int>(std::begin(indices), std::end(indices)))
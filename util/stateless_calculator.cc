@@ -0,0 +1,36 @@
+#include "mediapipe/calculators/custom/util/stateless_calculator.h"
+
+#include <mutex>
+#include <set>
+
+namespace mediapipe
+{
+
+    namespace
+    {
+        std::mutex& RegistryMutex()
+        {
+            static std::mutex* mutex = new std::mutex;
+            return *mutex;
+        }
+
+        std::set<std::string>& Registry()
+        {
+            static auto* registry = new std::set<std::string>;
+            return *registry;
+        }
+    } // namespace
+
+    bool StatelessCalculatorRegistry::Register(const std::string& name)
+    {
+        std::lock_guard<std::mutex> lock(RegistryMutex());
+        return Registry().insert(name).second;
+    }
+
+    bool StatelessCalculatorRegistry::IsRegistered(const std::string& name)
+    {
+        std::lock_guard<std::mutex> lock(RegistryMutex());
+        return Registry().count(name) > 0;
+    }
+
+} // namespace mediapipe
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <string>
+
+namespace mediapipe
+{
+
+    /**
+     * @brief Registry of calculators declared safe for parallel invocation
+     *
+     * A stateless calculator produces each output from the inputs at the same
+     * timestamp only, so several instances can process different frames at
+     * once. ParallelStageSubgraph refuses to replicate any other calculator.
+     */
+    class StatelessCalculatorRegistry
+    {
+    public:
+        static bool Register(const std::string& name);
+        static bool IsRegistered(const std::string& name);
+    };
+
+} // namespace mediapipe
+
+// Declares a registered calculator stateless; place next to REGISTER_CALCULATOR
+#define REGISTER_STATELESS_CALCULATOR(name)                            \
+    static const bool stateless_calculator_registered_##name =         \
+        ::mediapipe::StatelessCalculatorRegistry::Register(#name)
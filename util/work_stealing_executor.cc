@@ -0,0 +1,180 @@
+#include "mediapipe/calculators/custom/util/work_stealing_executor.h"
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "mediapipe/framework/port/logging.h"
+
+namespace mediapipe
+{
+
+    namespace
+    {
+        // Identifies the executor and worker the current thread belongs to
+        thread_local const WorkStealingExecutor* t_executor = nullptr;
+        thread_local size_t t_worker_index = 0;
+
+        // CPUs this process may run on, which a cgroup or taskset can make
+        // fewer than the hardware threads and not numbered from 0
+        std::vector<int> AllowedCpus()
+        {
+            std::vector<int> cpus;
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            if (sched_getaffinity(0, sizeof(set), &set) == 0)
+            {
+                for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+                {
+                    if (CPU_ISSET(cpu, &set)) { cpus.push_back(cpu); }
+                }
+            }
+            if (cpus.empty())
+            {
+                const int num_cpus = std::max(std::thread::hardware_concurrency(), 1u);
+                for (int cpu = 0; cpu < num_cpus; ++cpu) { cpus.push_back(cpu); }
+            }
+            return cpus;
+        }
+    } // namespace
+
+    // static
+    absl::StatusOr<Executor*> WorkStealingExecutor::Create(const MediaPipeOptions& extendable_options)
+    {
+        const auto& options = extendable_options.GetExtension(WorkStealingExecutorOptions::ext);
+        if (options.num_threads() < 0)
+        {
+            return absl::InvalidArgumentError("WorkStealingExecutor num_threads must not be negative");
+        }
+        if (options.first_cpu() < 0)
+        {
+            return absl::InvalidArgumentError("WorkStealingExecutor first_cpu must not be negative");
+        }
+        return new WorkStealingExecutor(options);
+    }
+
+    WorkStealingExecutor::WorkStealingExecutor(const WorkStealingExecutorOptions& options)
+        : m_options(options), m_allowed_cpus(AllowedCpus())
+    {
+        size_t num_threads = m_options.num_threads();
+        if (num_threads == 0) { num_threads = m_allowed_cpus.size(); }
+
+        // All deques exist before any worker may try to steal from them
+        m_workers.reserve(num_threads);
+        for (size_t i = 0; i < num_threads; ++i) { m_workers.push_back(absl::make_unique<Worker>()); }
+        for (size_t i = 0; i < num_threads; ++i)
+        {
+            m_workers[i]->thread = std::thread(&WorkStealingExecutor::RunWorker, this, i);
+        }
+    }
+
+    WorkStealingExecutor::~WorkStealingExecutor()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_sleep_mutex);
+            m_stopping.store(true, std::memory_order_seq_cst);
+        }
+        m_wake.notify_all();
+        for (auto& worker: m_workers) { worker->thread.join(); }
+    }
+
+    void WorkStealingExecutor::Schedule(std::function<void()> task)
+    {
+        const size_t index = t_executor == this ?
+            t_worker_index:
+            m_next_worker.fetch_add(1, std::memory_order_relaxed) % m_workers.size();
+        {
+            Worker& worker = *m_workers[index];
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            worker.tasks.push_back(std::move(task));
+        }
+
+        // Pairs with the sleeping worker's check of m_pending after raising m_sleeping
+        m_pending.fetch_add(1, std::memory_order_seq_cst);
+        if (m_sleeping.load(std::memory_order_seq_cst) > 0)
+        {
+            std::lock_guard<std::mutex> lock(m_sleep_mutex);
+            m_wake.notify_one();
+        }
+    } // Schedule()
+
+    bool WorkStealingExecutor::PopLocal(size_t index, std::function<void()>* task)
+    {
+        Worker& worker = *m_workers[index];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        if (worker.tasks.empty()) { return false; }
+        *task = std::move(worker.tasks.back());
+        worker.tasks.pop_back();
+        return true;
+    } // PopLocal()
+
+    bool WorkStealingExecutor::Steal(size_t index, std::function<void()>* task)
+    {
+        const size_t num_workers = m_workers.size();
+        for (size_t offset = 1; offset < num_workers; ++offset)
+        {
+            Worker& victim = *m_workers[(index + offset) % num_workers];
+            // Skip busy victims rather than queue up behind their owner
+            std::unique_lock<std::mutex> lock(victim.mutex, std::try_to_lock);
+            if (!lock.owns_lock() || victim.tasks.empty()) { continue; }
+            *task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+        return false;
+    } // Steal()
+
+    void WorkStealingExecutor::RunWorker(size_t index)
+    {
+        t_executor = this;
+        t_worker_index = index;
+
+        const std::string name = absl::StrCat(m_options.thread_name_prefix(), "/", index).substr(0, 15);
+        pthread_setname_np(pthread_self(), name.c_str());
+        if (m_options.pin_threads())
+        {
+            const size_t slot = (static_cast<size_t>(m_options.first_cpu()) + index) % m_allowed_cpus.size();
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            CPU_SET(m_allowed_cpus[slot], &cpus);
+            if (pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) != 0)
+            {
+                LOG(WARNING) << "WorkStealingExecutor could not pin worker " << index;
+            }
+        }
+
+        std::function<void()> task;
+        for (;;)
+        {
+            bool found = false;
+            for (int round = 0; !found && round <= m_options.spin_rounds(); ++round)
+            {
+                found = this->PopLocal(index, &task) || this->Steal(index, &task);
+                if (!found && m_pending.load(std::memory_order_relaxed) == 0) { break; }
+            }
+            if (found)
+            {
+                m_pending.fetch_sub(1, std::memory_order_relaxed);
+                task();
+                task = nullptr;
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(m_sleep_mutex);
+            m_sleeping.fetch_add(1, std::memory_order_seq_cst);
+            m_wake.wait(lock, [this] {
+                return m_pending.load(std::memory_order_seq_cst) > 0 || m_stopping.load(std::memory_order_seq_cst);
+            });
+            m_sleeping.fetch_sub(1, std::memory_order_relaxed);
+            if (m_stopping.load() && m_pending.load() == 0) { return; }
+        }
+    } // RunWorker()
+
+    REGISTER_EXECUTOR(WorkStealingExecutor);
+
+} // namespace mediapipe
@@ -0,0 +1,192 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/formats/landmark.pb.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+#include "mediapipe/framework/thread_pool_executor.h"
+#include "mediapipe/calculators/custom/util/work_stealing_executor.h"
+
+namespace mediapipe
+{
+
+    namespace
+    {
+        constexpr int kNumLandmarks = 478;
+        constexpr int kFramesPerGraph = 16;
+
+        enum ExecutorKind { THREAD_POOL_EXECUTOR = 0, WORK_STEALING_EXECUTOR = 1 };
+
+        int64_t NowNanos()
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()
+            ).count();
+        }
+
+        // A fixed face mesh; every frame of every graph carries a copy
+        NormalizedLandmarkList MakeMesh()
+        {
+            NormalizedLandmarkList mesh;
+            for (int i = 0; i < kNumLandmarks; ++i)
+            {
+                auto* landmark = mesh.add_landmark();
+                landmark->set_x(0.5f + 0.2f * std::sin(i * 0.37f));
+                landmark->set_y(0.5f + 0.2f * std::cos(i * 0.53f));
+                landmark->set_z(0.05f * std::sin(i * 0.11f));
+            }
+            return mesh;
+        }
+
+        // The per-face proctoring pipeline, from raw landmarks to ProctorResult
+        CalculatorGraphConfig ProctorConfig()
+        {
+            return ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+                input_stream: "face_landmarks"
+                node {
+                  calculator: "LandmarkStandardizationCalculator"
+                  input_stream: "face_landmarks"
+                  output_stream: "face_std_landmarks"
+                }
+                node {
+                  calculator: "EyeBlinkCalculator"
+                  input_stream: "face_std_landmarks"
+                  output_stream: "face_blinks"
+                }
+                node {
+                  calculator: "FaceOrientationCalculator"
+                  input_stream: "face_std_landmarks"
+                  output_stream: "face_orientations"
+                }
+                node {
+                  calculator: "FaceActivityCalculator"
+                  input_stream: "face_std_landmarks"
+                  output_stream: "face_activities"
+                }
+                node {
+                  calculator: "FaceMovementCalculator"
+                  input_stream: "face_landmarks"
+                  output_stream: "face_movement"
+                }
+                node {
+                  calculator: "ProctorResultCalculator"
+                  input_stream: "ALIGN:face_orientations"
+                  input_stream: "BLINK:face_blinks"
+                  input_stream: "ACTIVE:face_activities"
+                  input_stream: "MOVE:face_movement"
+                  output_stream: "RESULT:proctor_result"
+                }
+            )pb");
+        }
+
+        struct GraphRun
+        {
+            CalculatorGraph graph;
+            int64_t next_timestamp = 0;
+            std::mutex mutex;
+            // Send time of each frame still in flight, by timestamp
+            std::unordered_map<int64_t, int64_t> send_ns;
+            std::vector<int64_t> latencies_ns;
+        };
+
+        std::shared_ptr<Executor> MakeExecutor(int kind, int num_threads)
+        {
+            if (kind == WORK_STEALING_EXECUTOR)
+            {
+                WorkStealingExecutorOptions options;
+                options.set_num_threads(num_threads);
+                return std::make_shared<WorkStealingExecutor>(options);
+            }
+            return std::make_shared<ThreadPoolExecutor>(num_threads);
+        }
+
+        // Args: executor kind, concurrent graphs sharing the executor, as in a
+        // server running one proctoring graph per session. Each iteration
+        // sends kFramesPerGraph frames into every graph and waits until all
+        // graphs are idle; latency runs from sending a frame to its result.
+        void BM_ConcurrentGraphs(benchmark::State& state)
+        {
+            const int num_threads = std::max(std::thread::hardware_concurrency(), 1u);
+            auto executor = MakeExecutor(state.range(0), num_threads);
+            const int num_graphs = state.range(1);
+            const Packet mesh = MakePacket<NormalizedLandmarkList>(MakeMesh());
+
+            std::vector<std::unique_ptr<GraphRun>> runs;
+            for (int g = 0; g < num_graphs; ++g)
+            {
+                auto run = std::make_unique<GraphRun>();
+                GraphRun* run_ptr = run.get();
+                if (!run->graph.SetExecutor("", executor).ok() ||
+                    !run->graph.Initialize(ProctorConfig()).ok() ||
+                    !run->graph.ObserveOutputStream("proctor_result", [run_ptr](const Packet& packet) {
+                        const int64_t now_ns = NowNanos();
+                        std::lock_guard<std::mutex> lock(run_ptr->mutex);
+                        auto it = run_ptr->send_ns.find(packet.Timestamp().Value());
+                        if (it != run_ptr->send_ns.end())
+                        {
+                            run_ptr->latencies_ns.push_back(now_ns - it->second);
+                            run_ptr->send_ns.erase(it);
+                        }
+                        return absl::OkStatus();
+                    }).ok() ||
+                    !run->graph.StartRun({}).ok())
+                {
+                    state.SkipWithError("Could not start the graph");
+                    return;
+                }
+                runs.push_back(std::move(run));
+            }
+
+            for (auto _: state)
+            {
+                for (int f = 0; f < kFramesPerGraph; ++f)
+                {
+                    for (auto& run: runs)
+                    {
+                        const Timestamp timestamp(run->next_timestamp++);
+                        {
+                            std::lock_guard<std::mutex> lock(run->mutex);
+                            run->send_ns[timestamp.Value()] = NowNanos();
+                        }
+                        run->graph.AddPacketToInputStream("face_landmarks", mesh.At(timestamp)).IgnoreError();
+                    }
+                }
+                for (auto& run: runs) { run->graph.WaitUntilIdle().IgnoreError(); }
+            }
+
+            std::vector<int64_t> latencies_ns;
+            for (auto& run: runs)
+            {
+                run->graph.CloseAllInputStreams().IgnoreError();
+                run->graph.WaitUntilDone().IgnoreError();
+                latencies_ns.insert(latencies_ns.end(), run->latencies_ns.begin(), run->latencies_ns.end());
+            }
+            if (latencies_ns.empty()) { return; }
+
+            std::sort(latencies_ns.begin(), latencies_ns.end());
+            auto percentile_us = [&latencies_ns](double p) {
+                return latencies_ns[static_cast<size_t>(p * (latencies_ns.size() - 1))] / 1000.0;
+            };
+            state.SetItemsProcessed(latencies_ns.size());
+            state.counters["p50_us"] = percentile_us(0.50);
+            state.counters["p99_us"] = percentile_us(0.99);
+            state.counters["threads"] = num_threads;
+        }
+    } // namespace
+
+    BENCHMARK(BM_ConcurrentGraphs)
+        ->ArgNames({"work_stealing", "graphs"})
+        ->ArgsProduct({{THREAD_POOL_EXECUTOR, WORK_STEALING_EXECUTOR}, {8, 32, 128}})
+        ->Unit(benchmark::kMillisecond)
+        ->UseRealTime();
+
+} // namespace mediapipe